@@ -30,15 +30,21 @@ std::unique_ptr<RNInstance> createRNInstance(int id,
                                              napi_ref arkTsTurboModuleProviderRef,
                                              MutationsListener &&mutationsListener,
                                              MountingManager::CommandDispatcher &&commandDispatcher,
-                                             napi_ref measureTextFnRef,
                                              napi_ref napiEventDispatcherRef,
-                                             UITicker::Shared uiTicker) {
-    std::shared_ptr<TaskExecutor> taskExecutor = std::make_shared<TaskExecutor>(env);
+                                             UITicker::Shared uiTicker,
+                                             MutationsTransport mutationsTransport,
+                                             bool isPropsDiffingEnabled,
+                                             bool isAnimationFrameRateThrottlingEnabled,
+                                             HermesRuntimeConfig hermesRuntimeConfig) {
+    std::shared_ptr<TaskExecutor> taskExecutor =
+        std::make_shared<TaskExecutor>(env, [uiTicker] { return uiTicker->getNextFrameDeadline(); });
+    auto frameClock = std::make_shared<FrameClock>(uiTicker, isAnimationFrameRateThrottlingEnabled);
     auto mainThreadChannel = std::make_shared<ArkTSChannel>(taskExecutor, ArkJS(env), napiEventDispatcherRef);
     auto contextContainer = std::make_shared<facebook::react::ContextContainer>();
-    auto textMeasurer = std::make_shared<TextMeasurer>(env, measureTextFnRef, taskExecutor);
+    auto textMeasurer = std::make_shared<TextMeasurer>();
     auto shadowViewRegistry = std::make_shared<ShadowViewRegistry>();
     contextContainer->insert("textLayoutManagerDelegate", textMeasurer);
+    contextContainer->insert("textMeasurementCache", std::make_shared<facebook::react::TextMeasurementCache>());
     PackageProvider packageProvider;
     auto packages = packageProvider.getPackages({});
     packages.insert(packages.begin(), std::make_shared<RNOHCorePackage>(Package::Context{ .shadowViewRegistry = shadowViewRegistry }));
@@ -73,17 +79,21 @@ std::unique_ptr<RNInstance> createRNInstance(int id,
     auto turboModuleFactory = TurboModuleFactory(env, arkTsTurboModuleProviderRef,
                                                  std::move(componentJSIBinderByName),
                                                  taskExecutor,
-                                                 std::move(turboModuleFactoryDelegates));
+                                                 std::move(turboModuleFactoryDelegates),
+                                                 std::make_shared<ArkTSCallQueue>(env, taskExecutor),
+                                                 frameClock);
     return std::make_unique<RNInstance>(id,
                                         contextContainer,
                                         std::move(turboModuleFactory),
                                         taskExecutor,
                                         componentDescriptorProviderRegistry,
-                                        MutationsToNapiConverter(std::move(componentNapiBinderByName)),
+                                        MutationsToNapiConverter(std::move(componentNapiBinderByName), isPropsDiffingEnabled),
                                         eventEmitRequestHandlers,
                                         std::move(mutationsListener),
                                         std::move(commandDispatcher),
                                         mainThreadChannel,
-                                        uiTicker,
-                                        shadowViewRegistry);
+                                        frameClock,
+                                        shadowViewRegistry,
+                                        mutationsTransport,
+                                        hermesRuntimeConfig);
 }
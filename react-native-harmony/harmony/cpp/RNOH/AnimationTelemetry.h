@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <react/renderer/core/ReactPrimitives.h>
+
+namespace rnoh {
+
+/**
+ * Frame statistics of a single native animation, recorded on the animation thread.
+ */
+struct AnimationTelemetry {
+    facebook::react::Tag animationId;
+    facebook::react::Tag nodeTag;
+    // NOTE: "frames", "spring" or "decay"
+    std::string type;
+    bool isRunning = true;
+    // NOTE: false for animations that were stopped before reaching their end
+    bool hasCompleted = false;
+    uint64_t framesCount = 0;
+    /**
+     * Vsyncs the animation should have been updated on, but wasn't.
+     */
+    uint64_t droppedFramesCount = 0;
+    /**
+     * Frames whose delta was longer than the animation is allowed to simulate at once, e.g. spring frames clamped at
+     * MAX_DELTA_TIME_SEC. The animation lagged behind the wall clock on these frames.
+     */
+    uint64_t clampedFramesCount = 0;
+    int64_t maxFrameDeltaInNs = 0;
+    /**
+     * Time the animation thread spent evaluating the frames the animation was part of, nodes graph included.
+     */
+    int64_t totalEvaluationTimeInNs = 0;
+    int64_t maxEvaluationTimeInNs = 0;
+};
+
+/**
+ * Implemented by the TurboModule that runs native animations, so RNInstance can report their telemetry.
+ */
+class AnimationTelemetryProvider {
+  public:
+    virtual ~AnimationTelemetryProvider() = default;
+
+    virtual std::vector<AnimationTelemetry> getAnimationTelemetry() = 0;
+};
+
+} // namespace rnoh
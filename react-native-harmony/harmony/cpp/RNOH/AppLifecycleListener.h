@@ -0,0 +1,17 @@
+#pragma once
+
+namespace rnoh {
+
+/**
+ * Implemented by TurboModules that react to the app moving to the background and back. RNInstance notifies the
+ * TurboModules JS has already required, on the JS thread.
+ */
+class AppLifecycleListener {
+  public:
+    virtual ~AppLifecycleListener() = default;
+
+    virtual void onForeground() = 0;
+    virtual void onBackground() = 0;
+};
+
+} // namespace rnoh
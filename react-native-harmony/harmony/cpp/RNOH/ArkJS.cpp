@@ -193,6 +193,26 @@ napi_value ArkJS::createArray(std::vector<napi_value> values) {
     return result;
 }
 
+napi_value ArkJS::createArrayBuffer(std::shared_ptr<std::vector<uint8_t>> buffer) {
+    napi_value result;
+    // NOTE: the ArrayBuffer borrows the memory, which is released once the ArrayBuffer is garbage collected
+    auto bufferHolder = new std::shared_ptr<std::vector<uint8_t>>(std::move(buffer));
+    auto status = napi_create_external_arraybuffer(
+        m_env,
+        (*bufferHolder)->data(),
+        (*bufferHolder)->size(),
+        [](napi_env env, void *data, void *hint) {
+            delete static_cast<std::shared_ptr<std::vector<uint8_t>> *>(hint);
+        },
+        bufferHolder,
+        &result);
+    if (status != napi_ok) {
+        delete bufferHolder;
+    }
+    this->maybeThrowFromStatus(status, "Failed to create external array buffer");
+    return result;
+}
+
 std::vector<napi_value> ArkJS::getCallbackArgs(napi_callback_info info) {
     size_t argc;
     napi_get_cb_info(m_env, info, &argc, nullptr, nullptr, nullptr);
@@ -225,6 +245,10 @@ napi_value ArkJS::getObjectProperty(napi_value object, napi_value key) {
     return result;
 }
 
+napi_value ArkJS::getObjectProperty(napi_value object, rnoh::PropertyKey key) {
+    return getObjectProperty(object, key.getNapiValue(m_env));
+}
+
 bool ArkJS::getBoolean(napi_value value) {
     bool result;
     auto status = napi_get_value_bool(m_env, value, &result);
@@ -350,21 +374,21 @@ std::vector<folly::dynamic> ArkJS::getDynamics(std::vector<napi_value> values) {
 
 std::vector<napi_value> ArkJS::convertIntermediaryValuesToNapiValues(std::vector<IntermediaryArg> args) {
     std::vector<napi_value> napiArgs;
-    for (auto arg : args) {
-        napiArgs.push_back(convertIntermediaryValueToNapiValue(arg));
+    napiArgs.reserve(args.size());
+    for (auto &arg : args) {
+        napiArgs.push_back(convertIntermediaryValueToNapiValue(std::move(arg)));
     }
     return napiArgs;
 }
 
 napi_value ArkJS::convertIntermediaryValueToNapiValue(IntermediaryArg arg) {
-    try {
-        return this->createFromDynamic(std::get<folly::dynamic>(arg));
-    } catch (const std::bad_variant_access &e) {
+    if (auto value = std::get_if<rnoh::TransferableValue>(&arg)) {
+        return value->toNapi(m_env);
     }
-    try {
-        return this->createSingleUseCallback(std::move(std::get<IntermediaryCallback>(arg)));
-    } catch (const std::bad_variant_access &e) {
+    if (auto dynamic = std::get_if<folly::dynamic>(&arg)) {
+        return this->createFromDynamic(*dynamic);
     }
+    return this->createSingleUseCallback(std::move(std::get<IntermediaryCallback>(arg)));
 }
 
 RNOHNapiObjectBuilder::RNOHNapiObjectBuilder(napi_env env, ArkJS arkJs) : m_env(env), m_arkJs(arkJs) {
@@ -489,6 +513,10 @@ napi_value RNOHNapiObject::getProperty(napi_value key) {
     return m_arkJs.getObjectProperty(m_object, key);
 }
 
+napi_value RNOHNapiObject::getProperty(rnoh::PropertyKey key) {
+    return m_arkJs.getObjectProperty(m_object, key);
+}
+
 std::vector<std::pair<napi_value, napi_value>> RNOHNapiObject::getKeyValuePairs() {
     return m_arkJs.getObjectProperties(m_object);
 }
@@ -7,10 +7,13 @@
 #include <string>
 #include <functional>
 #include <variant>
+#include <memory>
 #include <folly/dynamic.h>
 #include <react/renderer/graphics/Float.h>
 #include <react/renderer/graphics/Color.h>
 #include <react/renderer/graphics/RectangleCorners.h>
+#include "RNOH/PropertyKey.h"
+#include "RNOH/TransferableValue.h"
 
 class RNOHNapiObjectBuilder;
 class RNOHNapiObject;
@@ -18,7 +21,7 @@ class RNOHNapiObject;
 class ArkJS {
   public:
     using IntermediaryCallback = std::function<void(std::vector<folly::dynamic>)>;
-    using IntermediaryArg = std::variant<folly::dynamic, IntermediaryCallback>;
+    using IntermediaryArg = std::variant<folly::dynamic, IntermediaryCallback, rnoh::TransferableValue>;
 
     ArkJS(napi_env env);
 
@@ -49,6 +52,8 @@ class ArkJS {
 
     napi_value createArray(std::vector<napi_value>);
 
+    napi_value createArrayBuffer(std::shared_ptr<std::vector<uint8_t>> buffer);
+
     std::vector<napi_value> createFromDynamics(std::vector<folly::dynamic>);
 
     napi_value createFromDynamic(folly::dynamic);
@@ -77,6 +82,8 @@ class ArkJS {
 
     napi_value getObjectProperty(napi_value object, napi_value key);
 
+    napi_value getObjectProperty(napi_value object, rnoh::PropertyKey key);
+
     bool getBoolean(napi_value value);
 
     double getDouble(napi_value value);
@@ -134,6 +141,8 @@ class RNOHNapiObject {
 
     napi_value getProperty(napi_value key);
 
+    napi_value getProperty(rnoh::PropertyKey key);
+
     std::vector<std::pair<napi_value, napi_value>> getKeyValuePairs();
 
   private:
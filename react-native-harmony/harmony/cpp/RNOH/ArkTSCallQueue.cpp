@@ -0,0 +1,104 @@
+#include "RNOH/ArkTSCallQueue.h"
+
+#include <limits>
+#include <map>
+#include <glog/logging.h>
+
+using namespace rnoh;
+
+void ArkTSCallQueue::enqueue(std::unique_ptr<Call> call) {
+    // NOTE: counted before the call becomes visible, so `drainUntil` never executes calls that weren't counted yet
+    m_enqueuedCallsCount.fetch_add(1, std::memory_order_acq_rel);
+    if (m_isOverflowing.load(std::memory_order_acquire) || !m_ringBuffer.tryPush(std::move(call))) {
+        std::lock_guard<std::mutex> lock(m_overflowMutex);
+        m_isOverflowing.store(true, std::memory_order_release);
+        m_overflow.push_back(std::move(call));
+    }
+    scheduleDrain();
+}
+
+void ArkTSCallQueue::scheduleDrain() {
+    if (m_isDrainScheduled.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    m_taskExecutor->runTask(TaskThread::MAIN, [weakSelf = weak_from_this()] {
+        if (auto self = weakSelf.lock()) {
+            self->drain();
+        }
+    });
+}
+
+void ArkTSCallQueue::drain() {
+    drainUntil(std::numeric_limits<uint64_t>::max());
+}
+
+void ArkTSCallQueue::drainUntil(uint64_t enqueuedCallsCount) {
+    // NOTE: reset before popping, so calls enqueued while draining schedule the next drain
+    m_isDrainScheduled.store(false, std::memory_order_release);
+    std::vector<std::unique_ptr<Call>> batch;
+    std::unique_ptr<Call> call;
+    while (m_drainedCallsCount < enqueuedCallsCount && m_ringBuffer.tryPop(call)) {
+        batch.push_back(std::move(call));
+        m_drainedCallsCount++;
+    }
+    if (m_drainedCallsCount < enqueuedCallsCount && m_isOverflowing.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(m_overflowMutex);
+        while (m_drainedCallsCount < enqueuedCallsCount && m_ringBuffer.tryPop(call)) {
+            batch.push_back(std::move(call));
+            m_drainedCallsCount++;
+        }
+        while (m_drainedCallsCount < enqueuedCallsCount && !m_overflow.empty()) {
+            batch.push_back(std::move(m_overflow.front()));
+            m_overflow.pop_front();
+            m_drainedCallsCount++;
+        }
+        if (m_overflow.empty()) {
+            m_isOverflowing.store(false, std::memory_order_release);
+        }
+    }
+    if (m_drainedCallsCount < getEnqueuedCallsCount()) {
+        // NOTE: calls left behind by a partial drain, or still being enqueued, need another drain
+        scheduleDrain();
+    }
+    if (batch.empty()) {
+        return;
+    }
+
+    std::map<std::pair<napi_ref, std::string>, size_t> lastIdxByCoalescingKey;
+    for (size_t i = 0; i < batch.size(); i++) {
+        if (batch[i]->isCoalescable) {
+            lastIdxByCoalescingKey[{batch[i]->arkTsTurboModuleInstanceRef, batch[i]->methodName}] = i;
+        }
+    }
+    for (size_t i = 0; i < batch.size(); i++) {
+        auto &batchedCall = *batch[i];
+        if (batchedCall.isCoalescable &&
+            lastIdxByCoalescingKey[{batchedCall.arkTsTurboModuleInstanceRef, batchedCall.methodName}] != i) {
+            continue;
+        }
+        execute(batchedCall);
+    }
+}
+
+void ArkTSCallQueue::execute(Call &call) {
+    napi_handle_scope scope;
+    if (napi_open_handle_scope(m_env, &scope) != napi_ok) {
+        LOG(ERROR) << "Failed to open handle scope";
+        return;
+    }
+    try {
+        ArkJS arkJs(m_env);
+        auto napiArgs = arkJs.convertIntermediaryValuesToNapiValues(std::move(call.args));
+        auto napiResult = arkJs.getObject(call.arkTsTurboModuleInstanceRef).call(call.methodName, napiArgs);
+        if (call.onSuccess) {
+            call.onSuccess(arkJs, napiResult);
+        }
+    } catch (std::exception const &e) {
+        if (call.onError) {
+            call.onError(e.what());
+        } else {
+            LOG(ERROR) << "Exception thrown while calling TurboModule method " << call.methodName << ": " << e.what();
+        }
+    }
+    napi_close_handle_scope(m_env, scope);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <napi/native_api.h>
+
+#include "RNOH/ArkJS.h"
+#include "RNOH/MPSCRingBuffer.h"
+#include "RNOH/TaskExecutor/TaskExecutor.h"
+
+namespace rnoh {
+
+/**
+ * Batches calls to ArkTS TurboModules. Calls can be enqueued from any thread and are executed in order on the main
+ * thread. Enqueuing is lock-free, and a batch costs a single main thread task, regardless of the number of calls in it.
+ *
+ * Ordering relative to other main thread work:
+ * - synchronous ArkTSTurboModule calls first execute the calls enqueued before them (see `drainUntil`), so they run
+ *   after those, but don't wait for calls other threads enqueue in the meantime,
+ * - the drain task is posted with NORMAL priority when the first call of a batch is enqueued; calls enqueued after
+ *   that, until the task runs, join the batch and therefore run before MAIN tasks posted in the meantime.
+ * Callers that need a call to run after a specific MAIN task must post it from that task instead.
+ */
+class ArkTSCallQueue : public std::enable_shared_from_this<ArkTSCallQueue> {
+  public:
+    using Shared = std::shared_ptr<ArkTSCallQueue>;
+
+    struct Call {
+        napi_ref arkTsTurboModuleInstanceRef;
+        std::string methodName;
+        std::vector<ArkJS::IntermediaryArg> args;
+        /**
+         * Only the last coalescable call to a given method in a batch is executed.
+         */
+        bool isCoalescable = false;
+        std::function<void(ArkJS &arkJs, napi_value result)> onSuccess = nullptr;
+        std::function<void(std::string const &errorMessage)> onError = nullptr;
+    };
+
+    ArkTSCallQueue(napi_env env, TaskExecutor::Shared taskExecutor, size_t capacity = 1024)
+        : m_env(env), m_taskExecutor(std::move(taskExecutor)), m_ringBuffer(capacity) {}
+
+    void enqueue(std::unique_ptr<Call> call);
+
+    /**
+     * Includes calls that are being enqueued and may not be drainable yet.
+     */
+    uint64_t getEnqueuedCallsCount() const {
+        return m_enqueuedCallsCount.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Executes all enqueued calls. Must be called on the main thread.
+     */
+    void drain();
+
+    /**
+     * Executes calls in order until `enqueuedCallsCount` calls (as returned by `getEnqueuedCallsCount`) have been
+     * executed since the queue was created. A drain is scheduled for the calls left in the queue. Must be called on the
+     * main thread.
+     */
+    void drainUntil(uint64_t enqueuedCallsCount);
+
+  private:
+    void scheduleDrain();
+    void execute(Call &call);
+
+    napi_env m_env;
+    TaskExecutor::Shared m_taskExecutor;
+    MPSCRingBuffer<std::unique_ptr<Call>> m_ringBuffer;
+    std::atomic_bool m_isDrainScheduled = false;
+    std::atomic_uint64_t m_enqueuedCallsCount = 0;
+    // NOTE: accessed only on the main thread
+    uint64_t m_drainedCallsCount = 0;
+    // NOTE: used only when the ring buffer is full; once it's used, subsequent calls go there as well to preserve order
+    std::atomic_bool m_isOverflowing = false;
+    std::mutex m_overflowMutex;
+    std::deque<std::unique_ptr<Call>> m_overflow;
+};
+
+} // namespace rnoh
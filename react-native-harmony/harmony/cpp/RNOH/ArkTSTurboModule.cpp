@@ -9,6 +9,7 @@
 #include "RNOH/JsiConversions.h"
 #include "RNOH/ArkTSTurboModule.h"
 #include "RNOH/TaskExecutor/TaskExecutor.h"
+#include "RNOH/TransferableValue.h"
 #include "ArkTSTurboModule.h"
 
 using namespace rnoh;
@@ -27,16 +28,20 @@ ArkTSTurboModule::ArkTSTurboModule(Context ctx, std::string name) : m_ctx(ctx),
 
 // calls a TurboModule method and blocks until it returns, returning its result
 jsi::Value ArkTSTurboModule::call(jsi::Runtime &runtime, const std::string &methodName, const jsi::Value *jsiArgs, size_t argsCount) {
-    folly::dynamic result;
+    TransferableValue result;
     std::optional<std::exception> thrownError = std::nullopt;
     auto args = convertJSIValuesToIntermediaryValues(runtime, m_ctx.jsInvoker, jsiArgs, argsCount);
-    m_ctx.taskExecutor->runSyncTask(TaskThread::MAIN, [ctx = m_ctx, &name = name_, &thrownError, &methodName, &args, &result, &runtime]() {
+    auto enqueuedCallsCount = m_ctx.arkTsCallQueue->getEnqueuedCallsCount();
+    m_ctx.taskExecutor->runSyncTask(TaskThread::MAIN, [ctx = m_ctx, &name = name_, &thrownError, &methodName, &args, &result, &runtime, enqueuedCallsCount]() {
+        // NOTE: calls scheduled earlier must be executed first; the ones other threads enqueued since then don't have
+        // to be, so they don't add to the latency of this call
+        ctx.arkTsCallQueue->drainUntil(enqueuedCallsCount);
         try {
             ArkJS arkJs(ctx.env);
             auto napiArgs = arkJs.convertIntermediaryValuesToNapiValues(args);
             auto napiTurboModuleObject = arkJs.getObject(ctx.arkTsTurboModuleInstanceRef);
             auto napiResult = napiTurboModuleObject.call(methodName, napiArgs);
-            result = arkJs.getDynamic(napiResult);
+            result = TransferableValue::fromNapi(ctx.env, napiResult);
         } catch (const std::exception &e) {
             thrownError = e;
         }
@@ -44,73 +49,61 @@ jsi::Value ArkTSTurboModule::call(jsi::Runtime &runtime, const std::string &meth
     if (thrownError.has_value()) {
         throw thrownError;
     }
-    return jsi::valueFromDynamic(runtime, result);
+    return result.toJsi(runtime);
 }
 
 // calls a TurboModule method without blocking and ignores its result
-void rnoh::ArkTSTurboModule::scheduleCall(facebook::jsi::Runtime &runtime, const std::string &methodName, const facebook::jsi::Value *jsiArgs, size_t argsCount) {
-    auto args = convertJSIValuesToIntermediaryValues(runtime, m_ctx.jsInvoker, jsiArgs, argsCount);
-    m_ctx.taskExecutor->runTask(TaskThread::MAIN, [ctx = m_ctx, name = name_, methodName, args = std::move(args), &runtime]() {
-        try {
-            ArkJS arkJs(ctx.env);
-            auto napiArgs = arkJs.convertIntermediaryValuesToNapiValues(args);
-            auto napiTurboModuleObject = arkJs.getObject(ctx.arkTsTurboModuleInstanceRef);
-            napiTurboModuleObject.call(methodName, napiArgs);
-        } catch (const std::exception &e) {
-            LOG(ERROR) << "Exception thrown while calling " << name << " TurboModule method "<< methodName << ": " << e.what();
-        }
-    });
+void rnoh::ArkTSTurboModule::scheduleCall(facebook::jsi::Runtime &runtime, const std::string &methodName, const facebook::jsi::Value *jsiArgs, size_t argsCount, bool isCoalescable) {
+    auto call = std::make_unique<ArkTSCallQueue::Call>();
+    call->arkTsTurboModuleInstanceRef = m_ctx.arkTsTurboModuleInstanceRef;
+    call->methodName = methodName;
+    call->args = convertJSIValuesToIntermediaryValues(runtime, m_ctx.jsInvoker, jsiArgs, argsCount);
+    call->isCoalescable = isCoalescable;
+    call->onError = [name = name_, methodName](std::string const &errorMessage) {
+        LOG(ERROR) << "Exception thrown while calling " << name << " TurboModule method " << methodName << ": " << errorMessage;
+    };
+    m_ctx.arkTsCallQueue->enqueue(std::move(call));
 }
 
-// calls an async TurboModule method and returns a Promise
+// calls an async TurboModule method and returns a Promise, without blocking the JS thread
 jsi::Value ArkTSTurboModule::callAsync(jsi::Runtime &runtime, const std::string &methodName, const jsi::Value *jsiArgs, size_t argsCount) {
     auto args = convertJSIValuesToIntermediaryValues(runtime, m_ctx.jsInvoker, jsiArgs, argsCount);
-    napi_ref napiResultRef;
-    std::optional<std::exception> thrownError = std::nullopt;
-    m_ctx.taskExecutor->runSyncTask(TaskThread::MAIN, [ctx = m_ctx, &thrownError, &methodName, &args, &runtime, &napiResultRef]() {
-        ArkJS arkJs(ctx.env);
-        auto napiArgs = arkJs.convertIntermediaryValuesToNapiValues(args);
-        auto napiTurboModuleObject = arkJs.getObject(ctx.arkTsTurboModuleInstanceRef);
-        try {
-            auto napiResult = napiTurboModuleObject.call(methodName, napiArgs);
-            napiResultRef = arkJs.createReference(napiResult);
-        } catch (std::exception const &e) {
-            thrownError = e;
-        }
-    });
-    
-    if (thrownError.has_value()) {
-        return react::createPromiseAsJSIValue(runtime, [ctx = m_ctx, message = thrownError->what()](auto &rt, auto jsiPromise) {
-            ctx.jsInvoker->invokeAsync([message, jsiPromise] {
-                jsiPromise->reject(message);
-                jsiPromise->allowRelease();
-            });
-        });
-    }
-    
     return react::createPromiseAsJSIValue(
-        runtime, [ctx = m_ctx, napiResultRef](jsi::Runtime &rt2, std::shared_ptr<react::Promise> jsiPromise) {
-            ctx.taskExecutor->runTask(TaskThread::MAIN, [ctx, napiResultRef, &rt2, jsiPromise]() {
-                ArkJS arkJs(ctx.env);
-                auto napiResult = arkJs.getReferenceValue(napiResultRef);
+        runtime, [ctx = m_ctx, methodName, args = std::move(args)](jsi::Runtime &rt2, std::shared_ptr<react::Promise> jsiPromise) mutable {
+            auto call = std::make_unique<ArkTSCallQueue::Call>();
+            call->arkTsTurboModuleInstanceRef = ctx.arkTsTurboModuleInstanceRef;
+            call->methodName = methodName;
+            // NOTE: the setup function is called once
+            call->args = std::move(args);
+            call->onSuccess = [ctx, &rt2, jsiPromise](ArkJS &arkJs, napi_value napiResult) {
+                if (!arkJs.isPromise(napiResult)) {
+                    ctx.jsInvoker->invokeAsync([&rt2, jsiPromise, result = TransferableValue::fromNapi(ctx.env, napiResult)]() {
+                        jsiPromise->resolve(result.toJsi(rt2));
+                        jsiPromise->allowRelease();
+                    });
+                    return;
+                }
                 Promise(ctx.env, napiResult)
-                    .then([&rt2, jsiPromise, ctx, napiResultRef](auto args) {
+                    .then([&rt2, jsiPromise, ctx](auto args) {
                         ctx.jsInvoker->invokeAsync([&rt2, jsiPromise, args = std::move(args)]() {
                             jsiPromise->resolve(preparePromiseResolverResult(rt2, args));
                             jsiPromise->allowRelease();
                         });
-                        ArkJS arkJs(ctx.env);
-                        arkJs.deleteReference(napiResultRef);
                     })
-                    .catch_([&rt2, jsiPromise, ctx, napiResultRef](auto args) {
+                    .catch_([&rt2, jsiPromise, ctx](auto args) {
                         ctx.jsInvoker->invokeAsync([&rt2, jsiPromise, args]() {
                             jsiPromise->reject(preparePromiseRejectionResult(args));
                             jsiPromise->allowRelease();
                         });
-                        ArkJS arkJs(ctx.env);
-                        arkJs.deleteReference(napiResultRef);
                     });
-            });
+            };
+            call->onError = [ctx, jsiPromise](std::string const &errorMessage) {
+                ctx.jsInvoker->invokeAsync([message = errorMessage, jsiPromise] {
+                    jsiPromise->reject(message);
+                    jsiPromise->allowRelease();
+                });
+            };
+            ctx.arkTsCallQueue->enqueue(std::move(call));
         });
 }
 
@@ -124,7 +117,8 @@ std::vector<IntermediaryArg> convertJSIValuesToIntermediaryValues(jsi::Runtime &
                 continue;
             }
         }
-        args[argIdx] = jsi::dynamicFromValue(runtime, jsiArgs[argIdx]);
+        // NOTE: copied straight into a buffer, which is turned into a napi value on the main thread
+        args[argIdx] = TransferableValue::fromJsi(runtime, jsiArgs[argIdx]);
     }
     return args;
 }
@@ -7,7 +7,9 @@
 #include <ReactCommon/TurboModuleUtils.h>
 
 #include "ArkJS.h"
+#include "RNOH/ArkTSCallQueue.h"
 #include "RNOH/EventDispatcher.h"
+#include "RNOH/FrameClock.h"
 #include "RNOH/TurboModule.h"
 #include "RNOH/TaskExecutor/TaskExecutor.h"
 
@@ -29,6 +31,17 @@
         return static_cast<ArkTSTurboModule &>(turboModule).callAsync(rt, #name, args, count); \
     }
 
+// NOTE: the method is called without waiting for its result, so it should return void
+#define ARK_SCHEDULE_METHOD_CALLER(name, isCoalescable)                                               \
+    [](                                                                                               \
+        facebook::jsi::Runtime &rt,                                                                   \
+        facebook::react::TurboModule &turboModule,                                                    \
+        const facebook::jsi::Value *args,                                                             \
+        size_t count) {                                                                               \
+        static_cast<ArkTSTurboModule &>(turboModule).scheduleCall(rt, #name, args, count, isCoalescable); \
+        return facebook::jsi::Value::undefined();                                                     \
+    }
+
 #define ARK_METHOD_METADATA(name, argc)          \
     {                                            \
         #name, { argc, ARK_METHOD_CALLER(name) } \
@@ -39,6 +52,22 @@
         #name, { argc, ARK_ASYNC_METHOD_CALLER(name) } \
     }
 
+#define ARK_SCHEDULE_METHOD_METADATA(name, argc)                \
+    {                                                           \
+        #name, { argc, ARK_SCHEDULE_METHOD_CALLER(name, false) } \
+    }
+
+// NOTE: use for void methods for which only the latest call matters, e.g. setters;
+// if the method is called multiple times within one batch, only the last call is executed
+#define ARK_COALESCABLE_METHOD_METADATA(name, argc)            \
+    {                                                          \
+        #name, { argc, ARK_SCHEDULE_METHOD_CALLER(name, true) } \
+    }
+
+namespace facebook::react {
+class Instance;
+} // namespace facebook::react
+
 namespace rnoh {
 
 class ArkTSTurboModule : public TurboModule {
@@ -48,6 +77,9 @@ class ArkTSTurboModule : public TurboModule {
         napi_ref arkTsTurboModuleInstanceRef;
         std::shared_ptr<TaskExecutor> taskExecutor;
         std::shared_ptr<EventDispatcher> eventDispatcher;
+        ArkTSCallQueue::Shared arkTsCallQueue;
+        FrameClock::Shared frameClock;
+        std::weak_ptr<facebook::react::Instance> instance;
     };
 
     ArkTSTurboModule(Context ctx, std::string name);
@@ -60,7 +92,8 @@ class ArkTSTurboModule : public TurboModule {
     void scheduleCall(facebook::jsi::Runtime &runtime,
                       const std::string &methodName,
                       const facebook::jsi::Value *args,
-                      size_t argsCount);
+                      size_t argsCount,
+                      bool isCoalescable = false);
 
     facebook::jsi::Value callAsync(facebook::jsi::Runtime &runtime,
                                    const std::string &methodName,
@@ -0,0 +1,31 @@
+#include "ArrayBufferJSBigString.h"
+#include <stdexcept>
+#include "RNOH/ArkJS.h"
+
+namespace rnoh {
+
+ArrayBufferJSBigString::ArrayBufferJSBigString(napi_env env, napi_value arrayBuffer, TaskExecutor::Weak taskExecutor)
+    : m_env(env), m_taskExecutor(std::move(taskExecutor)) {
+    void *data;
+    size_t length;
+    if (napi_get_arraybuffer_info(env, arrayBuffer, &data, &length) != napi_ok) {
+        throw std::runtime_error("Failed to read array buffer");
+    }
+    m_data = static_cast<char const *>(data);
+    m_size = length;
+    m_arrayBufferRef = ArkJS(env).createReference(arrayBuffer);
+}
+
+ArrayBufferJSBigString::~ArrayBufferJSBigString() {
+    auto taskExecutor = m_taskExecutor.lock();
+    if (taskExecutor == nullptr) {
+        // NOTE: the instance is being torn down with its threads; the reference lives as long as the env
+        return;
+    }
+    // NOTE: Hermes keeps the bytecode it runs until the runtime is destroyed, which happens on the JS thread
+    taskExecutor->runTask(TaskThread::MAIN, [env = m_env, arrayBufferRef = m_arrayBufferRef] {
+        ArkJS(env).deleteReference(arrayBufferRef);
+    });
+}
+
+} // namespace rnoh
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cxxreact/JSBigString.h>
+#include <napi/native_api.h>
+#include "RNOH/TaskExecutor/TaskExecutor.h"
+
+namespace rnoh {
+
+/**
+ * JSBigString that borrows the memory of an ArkTS ArrayBuffer instead of copying it. The ArrayBuffer is kept alive by
+ * a napi reference, released on the main thread once the string is destroyed. Must be created on the main thread.
+ *
+ * NOTE: unlike JSBigString::c_str() requires, the memory isn't NUL-terminated; only Hermes bytecode can be run from it
+ */
+class ArrayBufferJSBigString : public facebook::react::JSBigString {
+  public:
+    ArrayBufferJSBigString(napi_env env, napi_value arrayBuffer, TaskExecutor::Weak taskExecutor);
+
+    ~ArrayBufferJSBigString() override;
+
+    bool isAscii() const override {
+        return false;
+    }
+
+    const char *c_str() const override {
+        return m_data;
+    }
+
+    size_t size() const override {
+        return m_size;
+    }
+
+  private:
+    napi_env m_env;
+    napi_ref m_arrayBufferRef;
+    TaskExecutor::Weak m_taskExecutor;
+    char const *m_data;
+    size_t m_size;
+};
+
+} // namespace rnoh
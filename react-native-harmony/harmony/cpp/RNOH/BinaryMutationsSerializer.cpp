@@ -0,0 +1,183 @@
+#include "RNOH/BinaryMutationsSerializer.h"
+#include "RNOH/RawPropsDiff.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <folly/dynamic.h>
+
+using namespace facebook;
+using namespace rnoh;
+
+namespace {
+
+class BufferWriter {
+  public:
+    BufferWriter(BinaryMutationsSerializer::Buffer &buffer) : m_buffer(buffer) {}
+
+    template <typename T>
+    void write(T value) {
+        auto offset = m_buffer.size();
+        m_buffer.resize(offset + sizeof(T));
+        std::memcpy(m_buffer.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    void writeAt(size_t offset, T value) {
+        std::memcpy(m_buffer.data() + offset, &value, sizeof(T));
+    }
+
+    void writeBytes(const char *data, size_t size) {
+        m_buffer.insert(m_buffer.end(), data, data + size);
+    }
+
+    size_t size() const {
+        return m_buffer.size();
+    }
+
+  private:
+    BinaryMutationsSerializer::Buffer &m_buffer;
+};
+
+class StringTable {
+  public:
+    uint32_t intern(std::string const &str) {
+        auto [it, inserted] = m_idByString.try_emplace(str, static_cast<uint32_t>(m_strings.size()));
+        if (inserted) {
+            m_strings.push_back(&it->first);
+        }
+        return it->second;
+    }
+
+    void writeTo(BufferWriter &writer) const {
+        for (auto str : m_strings) {
+            writer.write<uint32_t>(str->size());
+            writer.writeBytes(str->data(), str->size());
+        }
+    }
+
+    uint32_t size() const {
+        return m_strings.size();
+    }
+
+  private:
+    std::unordered_map<std::string, uint32_t> m_idByString;
+    // NOTE: keys of unordered_map have stable addresses
+    std::vector<std::string const *> m_strings;
+};
+
+void writeValue(BufferWriter &writer, StringTable &strings, folly::dynamic const &value) {
+    using ValueType = BinaryMutationsSerializer::ValueType;
+    switch (value.type()) {
+    case folly::dynamic::Type::NULLT:
+        writer.write<uint8_t>(ValueType::NULL_VALUE);
+        break;
+    case folly::dynamic::Type::BOOL:
+        writer.write<uint8_t>(value.getBool() ? ValueType::TRUE_VALUE : ValueType::FALSE_VALUE);
+        break;
+    case folly::dynamic::Type::INT64:
+    case folly::dynamic::Type::DOUBLE:
+        writer.write<uint8_t>(ValueType::NUMBER);
+        writer.write<double>(value.asDouble());
+        break;
+    case folly::dynamic::Type::STRING:
+        writer.write<uint8_t>(ValueType::STRING);
+        writer.write<uint32_t>(strings.intern(value.getString()));
+        break;
+    case folly::dynamic::Type::ARRAY:
+        writer.write<uint8_t>(ValueType::ARRAY);
+        writer.write<uint32_t>(value.size());
+        for (auto const &item : value) {
+            writeValue(writer, strings, item);
+        }
+        break;
+    case folly::dynamic::Type::OBJECT:
+        writer.write<uint8_t>(ValueType::OBJECT);
+        writer.write<uint32_t>(value.size());
+        for (auto const &[key, item] : value.items()) {
+            writer.write<uint32_t>(strings.intern(key.asString()));
+            writeValue(writer, strings, item);
+        }
+        break;
+    }
+}
+
+} // namespace
+
+std::shared_ptr<BinaryMutationsSerializer::Buffer> BinaryMutationsSerializer::serialize(react::ShadowViewMutationList const &mutations) const {
+    auto result = std::make_shared<Buffer>();
+    Buffer values;
+    BufferWriter writer(*result);
+    BufferWriter valuesWriter(values);
+    StringTable strings;
+
+    result->reserve(HEADER_SIZE + mutations.size() * RECORD_SIZE);
+    result->resize(HEADER_SIZE);
+    for (auto const &mutation : mutations) {
+        auto const &shadowView = mutation.type == react::ShadowViewMutation::Create ||
+                                         mutation.type == react::ShadowViewMutation::Insert ||
+                                         mutation.type == react::ShadowViewMutation::Update
+                                     ? mutation.newChildShadowView
+                                     : mutation.oldChildShadowView;
+        auto hasDescriptor = mutation.type == react::ShadowViewMutation::Create || mutation.type == react::ShadowViewMutation::Update;
+        uint16_t flags = 0;
+        uint32_t componentNameId = NO_VALUE;
+        uint32_t propsOffset = NO_VALUE;
+        auto indexOrNativeIdId = static_cast<uint32_t>(mutation.index);
+        if (hasDescriptor) {
+            componentNameId = strings.intern(shadowView.componentName);
+            indexOrNativeIdId = shadowView.props == nullptr || shadowView.props->nativeId.empty()
+                                    ? NO_VALUE
+                                    : strings.intern(shadowView.props->nativeId);
+            if (hasNapiBinder(shadowView.componentName)) {
+                flags |= RecordFlag::HAS_NAPI_BINDER;
+            }
+            if (m_isPropsDiffingEnabled && mutation.type == react::ShadowViewMutation::Update) {
+                if (!RawPropsDiff::didLayoutMetricsChange(mutation.oldChildShadowView, shadowView)) {
+                    flags |= RecordFlag::LAYOUT_METRICS_UNCHANGED;
+                }
+                auto rawPropsDiff = RawPropsDiff::create(mutation.oldChildShadowView, shadowView);
+                propsOffset = valuesWriter.size();
+                writeValue(valuesWriter, strings, rawPropsDiff.changedProps);
+                if (!rawPropsDiff.removedPropNames.empty()) {
+                    flags |= RecordFlag::HAS_REMOVED_PROPS;
+                    valuesWriter.write<uint8_t>(ValueType::ARRAY);
+                    valuesWriter.write<uint32_t>(rawPropsDiff.removedPropNames.size());
+                    for (auto const &propName : rawPropsDiff.removedPropNames) {
+                        valuesWriter.write<uint8_t>(ValueType::STRING);
+                        valuesWriter.write<uint32_t>(strings.intern(propName));
+                    }
+                }
+            } else if (shadowView.props != nullptr) {
+                propsOffset = valuesWriter.size();
+                writeValue(valuesWriter, strings, shadowView.props->rawProps);
+            }
+        }
+        auto const &frame = shadowView.layoutMetrics.frame;
+        writer.write<uint8_t>(mutation.type);
+        writer.write<uint8_t>(static_cast<uint8_t>(shadowView.layoutMetrics.layoutDirection));
+        writer.write<uint16_t>(flags);
+        writer.write<int32_t>(shadowView.tag);
+        writer.write<int32_t>(mutation.parentShadowView.tag);
+        writer.write<uint32_t>(indexOrNativeIdId);
+        writer.write<uint32_t>(componentNameId);
+        writer.write<uint32_t>(propsOffset);
+        writer.write<double>(frame.origin.x);
+        writer.write<double>(frame.origin.y);
+        writer.write<double>(frame.size.width);
+        writer.write<double>(frame.size.height);
+    }
+
+    uint32_t stringsOffset = writer.size();
+    strings.writeTo(writer);
+    uint32_t valuesOffset = writer.size();
+    writer.writeBytes(reinterpret_cast<const char *>(values.data()), values.size());
+
+    writer.writeAt<uint32_t>(0, MAGIC);
+    writer.writeAt<uint16_t>(4, VERSION);
+    writer.writeAt<uint16_t>(6, 0);
+    writer.writeAt<uint32_t>(8, mutations.size());
+    writer.writeAt<uint32_t>(12, strings.size());
+    writer.writeAt<uint32_t>(16, stringsOffset);
+    writer.writeAt<uint32_t>(20, valuesOffset);
+    return result;
+}
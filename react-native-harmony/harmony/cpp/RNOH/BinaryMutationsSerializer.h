@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <react/renderer/mounting/ShadowViewMutation.h>
+
+namespace rnoh {
+
+/**
+ * Encodes a mutation list into a single buffer which is handed over to ArkTS as one ArrayBuffer,
+ * instead of building a napi object tree on the main thread. The encoding runs on the thread that
+ * committed the transaction. Must be kept in sync with BinaryMutationsDecoder.ts.
+ *
+ * Layout (little-endian):
+ *   header   HEADER_SIZE bytes: u32 magic, u16 version, u16 reserved, u32 mutationsCount,
+ *            u32 stringsCount, u32 stringsOffset, u32 valuesOffset
+ *   records  mutationsCount * RECORD_SIZE bytes:
+ *            u8 type, u8 layoutDirection, u16 flags, i32 tag, i32 parentTag, i32 index,
+ *            u32 componentNameId, u32 propsOffset, f64 x, f64 y, f64 width, f64 height
+ *            Create and Update records store the nativeID string id (or NO_VALUE) in place of `index`, so ArkTS can
+ *            index descriptors by nativeID without decoding their rawProps
+ *   strings  stringsCount * (u32 byteLength, UTF-8 bytes); component names, prop keys and string values are
+ *            interned and referenced by their index
+ *   values   tagged values (ValueType) referenced by `propsOffset` (relative to valuesOffset)
+ *
+ * When props diffing is enabled, Update records carry only changed rawProps, see RecordFlag.
+ */
+class BinaryMutationsSerializer {
+  public:
+    using Buffer = std::vector<uint8_t>;
+    using Shared = std::shared_ptr<BinaryMutationsSerializer>;
+
+    static constexpr uint32_t MAGIC = 0x424D4E52; // "RNMB"
+    static constexpr uint16_t VERSION = 2;
+    static constexpr uint32_t HEADER_SIZE = 24;
+    static constexpr uint32_t RECORD_SIZE = 56;
+    static constexpr uint32_t NO_VALUE = 0xFFFFFFFF;
+
+    enum RecordFlag : uint16_t {
+        // props and state of this record are delivered separately, because they are created by a ComponentNapiBinder
+        HAS_NAPI_BINDER = 1 << 0,
+        // Update record without layout metrics change; frame fields should be ignored
+        LAYOUT_METRICS_UNCHANGED = 1 << 1,
+        // Update record's props are followed by an ARRAY of names of removed props
+        HAS_REMOVED_PROPS = 1 << 2,
+    };
+
+    enum ValueType : uint8_t {
+        NULL_VALUE = 0,
+        FALSE_VALUE = 1,
+        TRUE_VALUE = 2,
+        NUMBER = 3,
+        STRING = 4,
+        ARRAY = 5,
+        OBJECT = 6,
+    };
+
+    BinaryMutationsSerializer(std::unordered_set<std::string> componentNamesWithNapiBinder, bool isPropsDiffingEnabled = false)
+        : m_componentNamesWithNapiBinder(std::move(componentNamesWithNapiBinder)),
+          m_isPropsDiffingEnabled(isPropsDiffingEnabled) {}
+
+    std::shared_ptr<Buffer> serialize(facebook::react::ShadowViewMutationList const &mutations) const;
+
+    bool hasNapiBinder(std::string const &componentName) const {
+        return m_componentNamesWithNapiBinder.count(componentName) > 0;
+    }
+
+  private:
+    std::unordered_set<std::string> m_componentNamesWithNapiBinder;
+    bool m_isPropsDiffingEnabled;
+};
+
+} // namespace rnoh
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "RNOH/UITicker.h"
+
+namespace rnoh {
+
+struct FrameInfo {
+    // NOTE: CLOCK_MONOTONIC nanoseconds, the same clock steady_clock uses
+    int64_t vsyncTimestampInNs;
+    int64_t targetFrameIntervalInNs;
+};
+
+/**
+ * Within a frame, listeners are called phase by phase, in this order.
+ */
+enum class FrameClockPhase {
+    TIMERS = 0,
+    ANIMATED,
+    LAYOUT_ANIMATION,
+};
+
+constexpr size_t FRAME_CLOCK_PHASES_COUNT = static_cast<size_t>(FrameClockPhase::LAYOUT_ANIMATION) + 1;
+
+/**
+ * Per-instance frame clock shared by JS timers, native Animated and layout animations. Makes at most one vsync request
+ * per frame for all of them, and hands every listener the same vsync timestamp, so all kinds of animations advance
+ * together. Listeners are called on the vsync thread and should post their work to their own thread.
+ */
+class FrameClock : public std::enable_shared_from_this<FrameClock> {
+  public:
+    using Shared = std::shared_ptr<FrameClock>;
+    using FrameListener = std::function<void(FrameInfo const &)>;
+
+    /**
+     * If `isFrameRateThrottlingEnabled`, vsyncs are skipped while every pending callback accepts a lower frame rate.
+     */
+    FrameClock(UITicker::Shared uiTicker, bool isFrameRateThrottlingEnabled = false)
+        : m_uiTicker(std::move(uiTicker)), m_isFrameRateThrottlingEnabled(isFrameRateThrottlingEnabled) {}
+
+    /**
+     * Calls `listener` on every frame until unsubscribed. The listener isn't called anymore once unsubscribe returns.
+     * Listeners may subscribe and unsubscribe (including themselves) while being called.
+     */
+    std::function<void()> subscribe(FrameClockPhase phase, FrameListener &&listener) {
+        auto subscription = std::make_shared<Subscription>(Subscription{.listener = std::move(listener)});
+        std::lock_guard lock(m_mtx);
+        auto id = m_nextListenerId++;
+        m_subscriptionsByPhase[static_cast<size_t>(phase)].emplace(id, std::move(subscription));
+        this->requestFrameIfNeeded();
+        return [weakSelf = weak_from_this(), phase, id] {
+            if (auto self = weakSelf.lock()) {
+                // NOTE: waits for a frame being dispatched on another thread, so the listener isn't called afterwards
+                std::lock_guard dispatchLock(self->m_dispatchMtx);
+                std::lock_guard lock(self->m_mtx);
+                auto &subscriptions = self->m_subscriptionsByPhase[static_cast<size_t>(phase)];
+                if (auto it = subscriptions.find(id); it != subscriptions.end()) {
+                    it->second->isActive = false;
+                    subscriptions.erase(it);
+                }
+            }
+        };
+    }
+
+    /**
+     * Calls `callback` once, on the next frame. Callbacks may request another frame.
+     * `minFrameIntervalInNs` is the shortest interval since the previous frame the callback benefits from.
+     */
+    void requestFrame(FrameClockPhase phase, FrameListener &&callback, int64_t minFrameIntervalInNs = 0) {
+        std::lock_guard lock(m_mtx);
+        m_frameCallbacksByPhase[static_cast<size_t>(phase)].push_back(std::move(callback));
+        m_minFrameIntervalInNs = std::min(m_minFrameIntervalInNs, minFrameIntervalInNs);
+        this->requestFrameIfNeeded();
+    }
+
+  private:
+    struct Subscription {
+        FrameListener listener;
+        // NOTE: guarded by m_dispatchMtx
+        bool isActive = true;
+    };
+
+    // NOTE: must be called with m_mtx held
+    void requestFrameIfNeeded() {
+        if (m_isFrameRequested) {
+            return;
+        }
+        bool hasListeners = false;
+        for (size_t i = 0; i < FRAME_CLOCK_PHASES_COUNT; i++) {
+            hasListeners |= !m_subscriptionsByPhase[i].empty() || !m_frameCallbacksByPhase[i].empty();
+        }
+        if (!hasListeners) {
+            return;
+        }
+        m_isFrameRequested = true;
+        m_uiTicker->requestFrameCallback([weakSelf = weak_from_this()](long long timestamp) {
+            if (auto self = weakSelf.lock()) {
+                self->onFrame(timestamp);
+            }
+        });
+    }
+
+    bool hasSubscribers() const {
+        return std::any_of(m_subscriptionsByPhase.begin(), m_subscriptionsByPhase.end(), [](auto const &subscriptions) {
+            return !subscriptions.empty();
+        });
+    }
+
+    void onFrame(long long timestamp) {
+        FrameInfo frameInfo{
+            .vsyncTimestampInNs = timestamp,
+            .targetFrameIntervalInNs = m_uiTicker->getFrameIntervalInNs(),
+        };
+        std::array<std::vector<FrameListener>, FRAME_CLOCK_PHASES_COUNT> frameCallbacksByPhase;
+        std::array<std::vector<std::shared_ptr<Subscription>>, FRAME_CLOCK_PHASES_COUNT> subscriptionsByPhase;
+        std::lock_guard dispatchLock(m_dispatchMtx);
+        std::unique_lock lock(m_mtx);
+        m_isFrameRequested = false;
+        if (m_isFrameRateThrottlingEnabled && !hasSubscribers() && m_lastFrameTimestampInNs > 0) {
+            // NOTE: half a vsync of tolerance, so e.g. every other vsync is used on a 120 Hz display for a 60 Hz request
+            auto timeSinceLastFrame = timestamp - m_lastFrameTimestampInNs + frameInfo.targetFrameIntervalInNs / 2;
+            if (timeSinceLastFrame < m_minFrameIntervalInNs) {
+                this->requestFrameIfNeeded();
+                return;
+            }
+        }
+        m_lastFrameTimestampInNs = timestamp;
+        m_minFrameIntervalInNs = std::numeric_limits<int64_t>::max();
+        std::swap(frameCallbacksByPhase, m_frameCallbacksByPhase);
+        for (size_t i = 0; i < FRAME_CLOCK_PHASES_COUNT; i++) {
+            for (auto const &idAndSubscription : m_subscriptionsByPhase[i]) {
+                subscriptionsByPhase[i].push_back(idAndSubscription.second);
+            }
+        }
+        // NOTE: listeners and callbacks are called without the lock, so they can subscribe, unsubscribe and request
+        // another frame
+        lock.unlock();
+        for (size_t i = 0; i < FRAME_CLOCK_PHASES_COUNT; i++) {
+            for (auto const &subscription : subscriptionsByPhase[i]) {
+                if (subscription->isActive) {
+                    subscription->listener(frameInfo);
+                }
+            }
+            for (auto const &frameCallback : frameCallbacksByPhase[i]) {
+                frameCallback(frameInfo);
+            }
+        }
+        lock.lock();
+        this->requestFrameIfNeeded();
+    }
+
+    UITicker::Shared m_uiTicker;
+    // NOTE: held while a frame is dispatched; recursive, so listeners can unsubscribe on the vsync thread
+    std::recursive_mutex m_dispatchMtx;
+    std::mutex m_mtx;
+    // NOTE: ordered by id, so listeners of a phase are called in the order they subscribed
+    std::array<std::map<uint64_t, std::shared_ptr<Subscription>>, FRAME_CLOCK_PHASES_COUNT> m_subscriptionsByPhase;
+    std::array<std::vector<FrameListener>, FRAME_CLOCK_PHASES_COUNT> m_frameCallbacksByPhase;
+    uint64_t m_nextListenerId = 0;
+    bool m_isFrameRequested = false;
+    bool m_isFrameRateThrottlingEnabled;
+    int64_t m_lastFrameTimestampInNs = 0;
+    // NOTE: the most demanding of the pending callbacks
+    int64_t m_minFrameIntervalInNs = std::numeric_limits<int64_t>::max();
+};
+
+} // namespace rnoh
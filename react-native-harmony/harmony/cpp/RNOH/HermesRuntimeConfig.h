@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace rnoh {
+
+/**
+ * Per-instance Hermes settings, passed in the options of createReactNativeInstance.
+ */
+struct HermesRuntimeConfig {
+    /**
+     * How eagerly the GC returns freed heap segments to the OS.
+     */
+    enum class ReleaseUnusedMemory {
+        DEFAULT,
+        NONE,
+        OLD_GENERATION,
+        YOUNG_GENERATION_ON_FULL_GC,
+        YOUNG_GENERATION_ALWAYS,
+    };
+
+    // NOTE: 0 keeps Hermes' default
+    uint32_t initialHeapSizeInBytes = 0;
+    // NOTE: 0 keeps Hermes' default
+    uint32_t maxHeapSizeInBytes = 0;
+    ReleaseUnusedMemory releaseUnusedMemory = ReleaseUnusedMemory::DEFAULT;
+    /**
+     * Makes Hermes collect GC timing, reported by RNInstance::getHermesHeapInfo.
+     */
+    bool shouldRecordGCStats = false;
+    /**
+     * On memory pressure, drops the resident pages of a bytecode bundle loaded from a file. They are read from the
+     * file again once the code they hold runs.
+     */
+    bool shouldEvictBytecodePagesOnMemoryPressure = false;
+};
+
+} // namespace rnoh
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace rnoh {
+
+/**
+ * Bounded, lock-free, multi-producer single-consumer queue (based on Dmitry Vyukov's bounded MPMC queue).
+ * `tryPush` may be called from any thread, `tryPop` only from the consumer thread.
+ */
+template <typename T>
+class MPSCRingBuffer {
+  public:
+    MPSCRingBuffer(size_t capacity) : m_cells(new Cell[capacity]), m_mask(capacity - 1) {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("MPSCRingBuffer capacity must be a power of two");
+        }
+        for (size_t i = 0; i < capacity; i++) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCRingBuffer(const MPSCRingBuffer &) = delete;
+    MPSCRingBuffer &operator=(const MPSCRingBuffer &) = delete;
+
+    /**
+     * Returns false if the buffer is full. `value` is moved only on success.
+     */
+    bool tryPush(T &&value) {
+        Cell *cell;
+        auto position = m_enqueuePosition.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &m_cells[position & m_mask];
+            auto sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (diff == 0) {
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T &value) {
+        auto &cell = m_cells[m_dequeuePosition & m_mask];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(m_dequeuePosition + 1) < 0) {
+            return false;
+        }
+        value = std::move(cell.value);
+        cell.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+        m_dequeuePosition++;
+        return true;
+    }
+
+  private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask;
+    alignas(64) std::atomic<size_t> m_enqueuePosition = 0;
+    alignas(64) size_t m_dequeuePosition = 0;
+};
+
+} // namespace rnoh
@@ -59,9 +59,13 @@ void MountingManager::performTransaction(facebook::react::MountingCoordinator::S
         },
         [this](react::MountingTransaction const &transaction, react::SurfaceTelemetry const &surfaceTelemetry) {
             // Did mount
-            taskExecutor->runTask(TaskThread::MAIN, [triggerUICallback=this->triggerUICallback, mutations = transaction.getMutations()] {
-                triggerUICallback(mutations);
-            });
+            BinaryMutations binaryMutations = nullptr;
+            if (serializeMutations != nullptr) {
+                binaryMutations = serializeMutations(transaction.getMutations());
+            }
+            taskExecutor->runTask(TaskThread::MAIN, [triggerUICallback=this->triggerUICallback, mutations = transaction.getMutations(), binaryMutations = std::move(binaryMutations)] {
+                triggerUICallback(mutations, binaryMutations);
+            }, TaskPriority::MOUNT);
         });
 }
 
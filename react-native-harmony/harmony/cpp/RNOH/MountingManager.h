@@ -18,14 +18,24 @@ namespace rnoh {
 
 class MountingManager {
   public:
-    using TriggerUICallback = std::function<void(facebook::react::ShadowViewMutationList const &mutations)>;
+    using BinaryMutations = std::shared_ptr<BinaryMutationsSerializer::Buffer>;
+    using TriggerUICallback = std::function<void(facebook::react::ShadowViewMutationList const &mutations, BinaryMutations binaryMutations)>;
     using CommandDispatcher = std::function<void(facebook::react::Tag tag, std::string const &commandName, folly::dynamic const args)>;
-
-    MountingManager(TaskExecutor::Shared taskExecutor, ShadowViewRegistry::Shared shadowViewRegistry, TriggerUICallback &&triggerUICallback, CommandDispatcher &&commandDispatcher)
+    /**
+     * Called on the thread which performs the transaction, before mutations are passed to the main thread.
+     */
+    using SerializeMutationsFn = std::function<BinaryMutations(facebook::react::ShadowViewMutationList const &mutations)>;
+
+    MountingManager(TaskExecutor::Shared taskExecutor,
+                    ShadowViewRegistry::Shared shadowViewRegistry,
+                    TriggerUICallback &&triggerUICallback,
+                    CommandDispatcher &&commandDispatcher,
+                    SerializeMutationsFn &&serializeMutations = nullptr)
         : taskExecutor(std::move(taskExecutor)),
           shadowViewRegistry(std::move(shadowViewRegistry)),
           triggerUICallback(std::move(triggerUICallback)),
-          commandDispatcher(std::move(commandDispatcher)) {}
+          commandDispatcher(std::move(commandDispatcher)),
+          serializeMutations(std::move(serializeMutations)) {}
 
     void performMountInstructions(facebook::react::ShadowViewMutationList const &mutations, facebook::react::SurfaceId surfaceId);
 
@@ -40,6 +50,7 @@ class MountingManager {
     ShadowViewRegistry::Shared shadowViewRegistry;
     TriggerUICallback triggerUICallback;
     CommandDispatcher commandDispatcher;
+    SerializeMutationsFn serializeMutations;
 };
 
 } // namespace rnoh
\ No newline at end of file
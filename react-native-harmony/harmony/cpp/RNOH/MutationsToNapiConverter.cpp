@@ -1,13 +1,21 @@
 #include "RNOH/ArkJS.h"
 #include "RNOH/MutationsToNapiConverter.h"
 #include "RNOH/BaseComponentNapiBinder.h"
+#include "RNOH/RawPropsDiff.h"
 #include "MutationsToNapiConverter.h"
 
 using namespace facebook;
 using namespace rnoh;
 
-MutationsToNapiConverter::MutationsToNapiConverter(ComponentNapiBinderByString &&componentNapiBinderByName)
-    : m_componentNapiBinderByName(std::move(componentNapiBinderByName)) {}
+MutationsToNapiConverter::MutationsToNapiConverter(ComponentNapiBinderByString &&componentNapiBinderByName, bool isPropsDiffingEnabled)
+    : m_componentNapiBinderByName(std::move(componentNapiBinderByName)),
+      m_isPropsDiffingEnabled(isPropsDiffingEnabled) {
+    std::unordered_set<std::string> componentNamesWithNapiBinder;
+    for (auto const &[componentName, _componentNapiBinder] : m_componentNapiBinderByName) {
+        componentNamesWithNapiBinder.insert(componentName);
+    }
+    m_binaryMutationsSerializer = std::make_shared<BinaryMutationsSerializer>(std::move(componentNamesWithNapiBinder), isPropsDiffingEnabled);
+}
 
 napi_value MutationsToNapiConverter::convert(napi_env env, react::ShadowViewMutationList const &mutations) {
     std::vector<napi_value> napiMutations;
@@ -27,8 +35,22 @@ napi_value MutationsToNapiConverter::convert(napi_env env, react::ShadowViewMuta
             break;
         }
         case react::ShadowViewMutation::Type::Update: {
+            if (!m_isPropsDiffingEnabled) {
+                objBuilder
+                    .addProperty("descriptor", this->convertShadowView(env, mutation.newChildShadowView));
+                break;
+            }
+            auto rawPropsDiff = RawPropsDiff::create(mutation.oldChildShadowView, mutation.newChildShadowView);
             objBuilder
-                .addProperty("descriptor", this->convertShadowView(env, mutation.newChildShadowView));
+                .addProperty("descriptor", this->convertShadowViewDiff(env, mutation.oldChildShadowView, mutation.newChildShadowView, rawPropsDiff.changedProps));
+            if (!rawPropsDiff.removedPropNames.empty()) {
+                std::vector<napi_value> removedPropNames;
+                removedPropNames.reserve(rawPropsDiff.removedPropNames.size());
+                for (auto const &propName : rawPropsDiff.removedPropNames) {
+                    removedPropNames.push_back(arkJs.createString(propName));
+                }
+                objBuilder.addProperty("removedRawPropNames", arkJs.createArray(removedPropNames));
+            }
             break;
         }
         case react::ShadowViewMutation::Type::Insert: {
@@ -48,6 +70,30 @@ napi_value MutationsToNapiConverter::convert(napi_env env, react::ShadowViewMuta
     return arkJs.createArray(napiMutations);
 }
 
+std::shared_ptr<BinaryMutationsSerializer::Buffer> MutationsToNapiConverter::serialize(react::ShadowViewMutationList const &mutations) const {
+    return m_binaryMutationsSerializer->serialize(mutations);
+}
+
+std::array<napi_value, 2> MutationsToNapiConverter::convert(napi_env env,
+                                                            react::ShadowViewMutationList const &mutations,
+                                                            std::shared_ptr<BinaryMutationsSerializer::Buffer> binaryMutations) {
+    ArkJS arkJs(env);
+    std::vector<napi_value> napiBinderPayloads;
+    for (auto &mutation : mutations) {
+        if (mutation.type != react::ShadowViewMutation::Type::Create && mutation.type != react::ShadowViewMutation::Type::Update) {
+            continue;
+        }
+        auto const &shadowView = mutation.newChildShadowView;
+        if (auto it = m_componentNapiBinderByName.find(shadowView.componentName); it != m_componentNapiBinderByName.end()) {
+            auto props = m_isPropsDiffingEnabled && mutation.type == react::ShadowViewMutation::Type::Update
+                             ? it->second->createPropsDiff(env, mutation.oldChildShadowView, shadowView)
+                             : it->second->createProps(env, shadowView);
+            napiBinderPayloads.push_back(arkJs.createArray({props, it->second->createState(env, shadowView)}));
+        }
+    }
+    return {arkJs.createArrayBuffer(std::move(binaryMutations)), arkJs.createArray(napiBinderPayloads)};
+}
+
 void rnoh::MutationsToNapiConverter::updateState(napi_env env, std::string const &componentName, facebook::react::State::Shared const &state, napi_value newState) {
     if (auto it = m_componentNapiBinderByName.find(componentName); it != m_componentNapiBinderByName.end()) {
         it->second->updateState({env, state, newState});
@@ -72,23 +118,7 @@ napi_value MutationsToNapiConverter::convertShadowView(napi_env env, react::Shad
             .addProperty("state", arkJs.createObjectBuilder().build());
     }
     descriptorBuilder
-        .addProperty("layoutMetrics",
-                     arkJs.createObjectBuilder()
-                         .addProperty("frame",
-                                      arkJs.createObjectBuilder()
-                                          .addProperty("origin",
-                                                       arkJs.createObjectBuilder()
-                                                           .addProperty("x", shadowView.layoutMetrics.frame.origin.x)
-                                                           .addProperty("y", shadowView.layoutMetrics.frame.origin.y)
-                                                           .build())
-                                          .addProperty("size",
-                                                       arkJs.createObjectBuilder()
-                                                           .addProperty("width", shadowView.layoutMetrics.frame.size.width)
-                                                           .addProperty("height", shadowView.layoutMetrics.frame.size.height)
-                                                           .build())
-                                          .build())
-                         .addProperty("layoutDirection", static_cast<int>(shadowView.layoutMetrics.layoutDirection))
-                         .build());
+        .addProperty("layoutMetrics", this->convertLayoutMetrics(env, shadowView.layoutMetrics));
 
     return descriptorBuilder
         .addProperty("tag", shadowView.tag)
@@ -97,3 +127,52 @@ napi_value MutationsToNapiConverter::convertShadowView(napi_env env, react::Shad
         .addProperty("rawProps", arkJs.createFromDynamic(shadowView.props->rawProps))
         .build();
 }
+
+napi_value MutationsToNapiConverter::convertShadowViewDiff(napi_env env,
+                                                           react::ShadowView const oldShadowView,
+                                                           react::ShadowView const newShadowView,
+                                                           folly::dynamic const &changedRawProps) {
+    ArkJS arkJs(env);
+    auto descriptorBuilder = arkJs.createObjectBuilder();
+    if (auto it = m_componentNapiBinderByName.find(newShadowView.componentName); it != m_componentNapiBinderByName.end()) {
+        descriptorBuilder
+            .addProperty("isDynamicBinder", arkJs.createBoolean(false))
+            .addProperty("props", it->second->createPropsDiff(env, oldShadowView, newShadowView))
+            .addProperty("state", it->second->createState(env, newShadowView));
+    } else {
+        // NOTE: props of dynamic binders are replaced with rawProps on the ArkTS side
+        descriptorBuilder
+            .addProperty("isDynamicBinder", arkJs.createBoolean(true))
+            .addProperty("props", arkJs.createObjectBuilder().build())
+            .addProperty("state", arkJs.createObjectBuilder().build());
+    }
+    if (RawPropsDiff::didLayoutMetricsChange(oldShadowView, newShadowView)) {
+        descriptorBuilder.addProperty("layoutMetrics", this->convertLayoutMetrics(env, newShadowView.layoutMetrics));
+    }
+    return descriptorBuilder
+        .addProperty("tag", newShadowView.tag)
+        .addProperty("type", newShadowView.componentName)
+        .addProperty("childrenTags", arkJs.createArray())
+        .addProperty("rawProps", arkJs.createFromDynamic(changedRawProps))
+        .build();
+}
+
+napi_value MutationsToNapiConverter::convertLayoutMetrics(napi_env env, react::LayoutMetrics const &layoutMetrics) {
+    ArkJS arkJs(env);
+    return arkJs.createObjectBuilder()
+        .addProperty("frame",
+                     arkJs.createObjectBuilder()
+                         .addProperty("origin",
+                                      arkJs.createObjectBuilder()
+                                          .addProperty("x", layoutMetrics.frame.origin.x)
+                                          .addProperty("y", layoutMetrics.frame.origin.y)
+                                          .build())
+                         .addProperty("size",
+                                      arkJs.createObjectBuilder()
+                                          .addProperty("width", layoutMetrics.frame.size.width)
+                                          .addProperty("height", layoutMetrics.frame.size.height)
+                                          .build())
+                         .build())
+        .addProperty("layoutDirection", static_cast<int>(layoutMetrics.layoutDirection))
+        .build();
+}
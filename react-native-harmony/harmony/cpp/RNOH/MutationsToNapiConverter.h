@@ -3,6 +3,7 @@
 #include <react/renderer/mounting/ShadowViewMutation.h>
 
 #include "RNOH/ArkJS.h"
+#include "RNOH/BinaryMutationsSerializer.h"
 
 namespace rnoh {
 
@@ -17,6 +18,13 @@ class ComponentNapiBinder {
     virtual napi_value createProps(napi_env env, facebook::react::ShadowView const shadowView) {
         return ArkJS(env).createObjectBuilder().build();
     };
+    /**
+     * Used for Update mutations when props diffing is enabled. Returned props are merged with the previous ones
+     * on the ArkTS side, so only changed props need to be returned.
+     */
+    virtual napi_value createPropsDiff(napi_env env, facebook::react::ShadowView const oldShadowView, facebook::react::ShadowView const newShadowView) {
+        return createProps(env, newShadowView);
+    };
     virtual napi_value createState(napi_env env, facebook::react::ShadowView const shadowView) {
         return ArkJS(env).createObjectBuilder().build();
     };
@@ -27,20 +35,51 @@ class ComponentNapiBinder {
 
 using ComponentNapiBinderByString = std::unordered_map<std::string, std::shared_ptr<ComponentNapiBinder>>;
 
+enum class MutationsTransport {
+    // each mutation is converted to a napi object on the main thread
+    OBJECTS,
+    // mutations are encoded off the main thread into a single ArrayBuffer, see BinaryMutationsSerializer
+    BINARY,
+};
+
 class MutationsToNapiConverter {
   public:
-    MutationsToNapiConverter(ComponentNapiBinderByString &&componentNapiBinderByName);
+    /**
+     * @param isPropsDiffingEnabled - Update mutations carry only changed rawProps (and names of removed ones),
+     * and layoutMetrics only if the frame changed
+     */
+    MutationsToNapiConverter(ComponentNapiBinderByString &&componentNapiBinderByName, bool isPropsDiffingEnabled = false);
 
     napi_value convert(
         napi_env env,
         facebook::react::ShadowViewMutationList const &mutations);
 
+    /**
+     * Thread-safe. Encodes everything that doesn't require napi, so it can be called before jumping to the main thread.
+     */
+    std::shared_ptr<BinaryMutationsSerializer::Buffer> serialize(facebook::react::ShadowViewMutationList const &mutations) const;
+
+    /**
+     * Returns [ArrayBuffer, napiBinderPayloads]. The buffer is passed without copying. `napiBinderPayloads` contains
+     * [props, state] pairs for records flagged with HAS_NAPI_BINDER, in the order of their occurrence.
+     */
+    std::array<napi_value, 2> convert(
+        napi_env env,
+        facebook::react::ShadowViewMutationList const &mutations,
+        std::shared_ptr<BinaryMutationsSerializer::Buffer> binaryMutations);
+
     void updateState(napi_env env, std::string const &componentName, facebook::react::State::Shared const &state, napi_value newState);
 
   private:
     napi_value convertShadowView(napi_env env, facebook::react::ShadowView const shadowView);
 
+    napi_value convertShadowViewDiff(napi_env env, facebook::react::ShadowView const oldShadowView, facebook::react::ShadowView const newShadowView, folly::dynamic const &changedRawProps);
+
+    napi_value convertLayoutMetrics(napi_env env, facebook::react::LayoutMetrics const &layoutMetrics);
+
     ComponentNapiBinderByString m_componentNapiBinderByName;
+    BinaryMutationsSerializer::Shared m_binaryMutationsSerializer;
+    bool m_isPropsDiffingEnabled;
 };
 
 } // namespace rnoh
\ No newline at end of file
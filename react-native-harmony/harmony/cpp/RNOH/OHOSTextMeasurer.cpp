@@ -0,0 +1,332 @@
+#include "RNOH/OHOSTextMeasurer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <folly/Hash.h>
+
+using namespace facebook;
+using namespace rnoh;
+
+namespace {
+size_t hashTextStorageKey(react::AttributedString const &attributedString, react::ParagraphAttributes const &paragraphAttributes) {
+    return folly::hash::hash_combine(0, react::textAttributedStringHashLayoutWise(attributedString), paragraphAttributes);
+}
+
+/**
+ * OH_Drawing reports line ranges in UTF-16 code units, while RN strings are UTF-8.
+ */
+size_t utf8OffsetFromUtf16Offset(std::string const &text, size_t utf8Offset, size_t utf16CodeUnitsCount) {
+    while (utf8Offset < text.size() && utf16CodeUnitsCount > 0) {
+        auto leadByte = static_cast<uint8_t>(text[utf8Offset]);
+        auto sequenceLength = leadByte < 0x80 ? 1 : leadByte < 0xE0 ? 2 : leadByte < 0xF0 ? 3 : 4;
+        auto utf16Length = sequenceLength == 4 ? 2 : 1;
+        utf8Offset = std::min(text.size(), utf8Offset + sequenceLength);
+        utf16CodeUnitsCount -= std::min<size_t>(utf16Length, utf16CodeUnitsCount);
+    }
+    return utf8Offset;
+}
+} // namespace
+
+react::TextMeasurement OHOSTextMeasurer::measure(react::AttributedString const &attributedString,
+                                                 react::ParagraphAttributes const &paragraphAttributes,
+                                                 react::LayoutConstraints const &layoutConstraints) {
+    if (attributedString.getFragments().empty()) {
+        return {{0, 0}, {}};
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto typography = createTypography(attributedString, paragraphAttributes, layoutConstraints.maximumSize.width);
+    return measure(typography);
+}
+
+react::TextMeasurement OHOSTextMeasurer::measure(react::AttributedString const &attributedString,
+                                                 react::ParagraphAttributes const &paragraphAttributes,
+                                                 react::LayoutConstraints const &layoutConstraints,
+                                                 std::shared_ptr<TextStorage> const &textStorage) {
+    if (attributedString.getFragments().empty()) {
+        return {{0, 0}, {}};
+    }
+    std::lock_guard<std::mutex> textStorageLock(textStorage->m_mutex);
+    // NOTE: RN reuses the storage as long as the layout-wise hash matches, which ignores attachments sizes
+    if (!textStorage->m_typography.has_value() ||
+        !react::areAttributedStringsEquivalentLayoutWise(attributedString, textStorage->m_attributedString) ||
+        !(paragraphAttributes == textStorage->m_paragraphAttributes)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto previousHash = textStorage->m_typography.has_value() ? std::optional<size_t>(textStorage->m_hash) : std::nullopt;
+        textStorage->m_typography = createTypography(attributedString, paragraphAttributes, layoutConstraints.maximumSize.width);
+        textStorage->m_attributedString = attributedString;
+        textStorage->m_paragraphAttributes = paragraphAttributes;
+        textStorage->m_hash = hashTextStorageKey(attributedString, paragraphAttributes);
+        trackTextStorage(textStorage, previousHash);
+    } else {
+        layout(*textStorage->m_typography, layoutConstraints.maximumSize.width);
+    }
+    return measure(*textStorage->m_typography);
+}
+
+std::shared_ptr<OHOSTextMeasurer::TextStorage> OHOSTextMeasurer::createTextStorage() {
+    return std::make_shared<TextStorage>();
+}
+
+void OHOSTextMeasurer::trackTextStorage(std::shared_ptr<TextStorage> const &textStorage, std::optional<size_t> previousHash) {
+    if (previousHash.has_value()) {
+        auto [begin, end] = m_textStoragesByHash.equal_range(previousHash.value());
+        for (auto it = begin; it != end; it++) {
+            if (it->second.lock() == textStorage) {
+                m_textStoragesByHash.erase(it);
+                break;
+            }
+        }
+    }
+    if (m_textStoragesByHash.size() >= 2 * m_textStoragesCountAfterLastPrune + 16 ||
+        m_textStoragesByHash.size() >= MAX_TRACKED_TEXT_STORAGES_COUNT) {
+        for (auto it = m_textStoragesByHash.begin(); it != m_textStoragesByHash.end();) {
+            it = it->second.expired() ? m_textStoragesByHash.erase(it) : std::next(it);
+        }
+        // NOTE: living storages are forgotten as well if needed, measureLines then creates a typography of its own
+        while (m_textStoragesByHash.size() >= MAX_TRACKED_TEXT_STORAGES_COUNT) {
+            m_textStoragesByHash.erase(m_textStoragesByHash.begin());
+        }
+        m_textStoragesCountAfterLastPrune = m_textStoragesByHash.size();
+    }
+    m_textStoragesByHash.emplace(textStorage->m_hash, textStorage);
+}
+
+react::LinesMeasurements OHOSTextMeasurer::measureLines(react::AttributedString const &attributedString,
+                                                        react::ParagraphAttributes const &paragraphAttributes,
+                                                        react::Size const &size) {
+    if (attributedString.getFragments().empty()) {
+        return {};
+    }
+    std::shared_ptr<TextStorage> textStorage = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto [begin, end] = m_textStoragesByHash.equal_range(hashTextStorageKey(attributedString, paragraphAttributes));
+        for (auto it = begin; it != end && !textStorage; it++) {
+            textStorage = it->second.lock();
+        }
+    }
+    if (textStorage) {
+        std::lock_guard<std::mutex> textStorageLock(textStorage->m_mutex);
+        if (textStorage->m_typography.has_value() &&
+            react::areAttributedStringsEquivalentLayoutWise(attributedString, textStorage->m_attributedString) &&
+            paragraphAttributes == textStorage->m_paragraphAttributes) {
+            layout(*textStorage->m_typography, size.width);
+            return measureLines(*textStorage->m_typography, attributedString.getString());
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto typography = createTypography(attributedString, paragraphAttributes, size.width);
+    return measureLines(typography, attributedString.getString());
+}
+
+OHOSTextMeasurer::Typography OHOSTextMeasurer::createTypography(react::AttributedString const &attributedString,
+                                                                react::ParagraphAttributes const &paragraphAttributes,
+                                                                react::Float maxWidth) {
+    // NOTE: clearing is done upfront, so styles pushed to the handler below stay alive until the typography is created
+    maybeClearStyles();
+    auto typographyHandler = OH_Drawing_CreateTypographyHandler(getTypographyStyle(paragraphAttributes.maximumNumberOfLines), m_fontCollection);
+    size_t attachmentsCount = 0;
+    for (auto const &fragment : attributedString.getFragments()) {
+        OH_Drawing_TypographyHandlerPushTextStyle(typographyHandler, getTextStyle(fragment.textAttributes));
+        if (fragment.isAttachment()) {
+            auto const &attachmentSize = fragment.parentShadowView.layoutMetrics.frame.size;
+            OH_Drawing_PlaceholderSpan placeholderSpan{
+                .width = attachmentSize.width,
+                .height = attachmentSize.height,
+                .alignment = OH_Drawing_PlaceholderVerticalAlignment::ALIGNMENT_ABOVE_BASELINE,
+                .baseline = OH_Drawing_TextBaseline::TEXT_BASELINE_ALPHABETIC,
+                .baselineOffset = 0,
+            };
+            OH_Drawing_TypographyHandlerAddPlaceholder(typographyHandler, &placeholderSpan);
+            attachmentsCount++;
+        } else {
+            OH_Drawing_TypographyHandlerAddText(typographyHandler, fragment.string.c_str());
+        }
+        OH_Drawing_TypographyHandlerPopTextStyle(typographyHandler);
+    }
+    Typography result{
+        .typography = std::unique_ptr<OH_Drawing_Typography, TypographyDeleter>(OH_Drawing_CreateTypography(typographyHandler)),
+        .attachmentsCount = attachmentsCount,
+        .layoutWidth = std::numeric_limits<react::Float>::quiet_NaN(),
+    };
+    OH_Drawing_DestroyTypographyHandler(typographyHandler);
+    layout(result, maxWidth);
+    return result;
+}
+
+void OHOSTextMeasurer::layout(Typography &typography, react::Float maxWidth) {
+    auto layoutWidth = std::isfinite(maxWidth) && maxWidth > 0 ? maxWidth : std::numeric_limits<react::Float>::max();
+    if (layoutWidth == typography.layoutWidth) {
+        return;
+    }
+    // NOTE: text isn't aligned, so lines are broken the same way for any width between the longest line and the
+    // width used previously, e.g. when measuring lines with the measured size
+    if (layoutWidth < typography.layoutWidth && OH_Drawing_TypographyGetLongestLine(typography.typography.get()) <= layoutWidth) {
+        return;
+    }
+    OH_Drawing_TypographyLayout(typography.typography.get(), layoutWidth);
+    typography.layoutWidth = layoutWidth;
+}
+
+react::TextMeasurement OHOSTextMeasurer::measure(Typography &typography) {
+    react::TextMeasurement result = {{0, 0}, {}};
+    result.size.width = OH_Drawing_TypographyGetLongestLine(typography.typography.get()) + 0.5 /* fixes unexpected wrap */;
+    result.size.height = OH_Drawing_TypographyGetHeight(typography.typography.get());
+
+    if (typography.attachmentsCount > 0) {
+        auto placeholderRects = OH_Drawing_TypographyGetRectsForPlaceholders(typography.typography.get());
+        // NOTE: placeholders truncated by maximumNumberOfLines have no rects, but RN expects a frame for each attachment
+        auto visibleAttachmentsCount = std::min(static_cast<size_t>(OH_Drawing_GetSizeOfTextBox(placeholderRects)), typography.attachmentsCount);
+        result.attachments.reserve(typography.attachmentsCount);
+        for (size_t i = 0; i < visibleAttachmentsCount; i++) {
+            react::TextMeasurement::Attachment attachment;
+            auto left = OH_Drawing_GetLeftFromTextBox(placeholderRects, i);
+            auto top = OH_Drawing_GetTopFromTextBox(placeholderRects, i);
+            attachment.frame.origin = {left, top};
+            attachment.frame.size = {OH_Drawing_GetRightFromTextBox(placeholderRects, i) - left,
+                                     OH_Drawing_GetBottomFromTextBox(placeholderRects, i) - top};
+            attachment.isClipped = false;
+            result.attachments.push_back(std::move(attachment));
+        }
+        OH_Drawing_TypographyDestroyTextBox(placeholderRects);
+        result.attachments.resize(typography.attachmentsCount, react::TextMeasurement::Attachment{{{0, 0}, {0, 0}}, true});
+    }
+    return result;
+}
+
+react::LinesMeasurements OHOSTextMeasurer::measureLines(Typography &typography, std::string const &text) {
+    react::LinesMeasurements result;
+    auto lineMetrics = OH_Drawing_TypographyGetLineMetrics(typography.typography.get());
+    if (lineMetrics == nullptr) {
+        return result;
+    }
+    auto linesCount = OH_Drawing_LineMetricsGetSize(lineMetrics);
+    result.reserve(linesCount);
+    size_t utf16Offset = 0;
+    size_t utf8Offset = 0;
+    for (size_t i = 0; i < linesCount; i++) {
+        auto const &line = lineMetrics[i];
+        auto lineStart = utf8OffsetFromUtf16Offset(text, utf8Offset, line.startIndex - std::min(line.startIndex, utf16Offset));
+        auto lineEnd = utf8OffsetFromUtf16Offset(text, lineStart, line.endIndex - std::min(line.endIndex, line.startIndex));
+        utf16Offset = line.endIndex;
+        utf8Offset = lineEnd;
+        result.emplace_back(
+            text.substr(lineStart, lineEnd - lineStart),
+            react::Rect{{line.x, line.y}, {line.width, line.height}},
+            line.descender,
+            line.capHeight,
+            line.ascender,
+            line.xHeight);
+    }
+    OH_Drawing_DestroyLineMetrics(lineMetrics);
+    return result;
+}
+
+OH_Drawing_TypographyStyle *OHOSTextMeasurer::getTypographyStyle(int maximumNumberOfLines) {
+    if (auto it = m_typographyStyleByMaxLines.find(maximumNumberOfLines); it != m_typographyStyleByMaxLines.end()) {
+        return it->second;
+    }
+    auto typographyStyle = OH_Drawing_CreateTypographyStyle();
+    if (maximumNumberOfLines) {
+        OH_Drawing_SetTypographyTextMaxLines(typographyStyle, maximumNumberOfLines);
+    }
+    m_typographyStyleByMaxLines.emplace(maximumNumberOfLines, typographyStyle);
+    return typographyStyle;
+}
+
+OH_Drawing_TextStyle *OHOSTextMeasurer::getTextStyle(react::TextAttributes const &textAttributes) {
+    // NOTE: unset attributes are NaN, which would never compare equal, so they are stored as 0
+    auto valueOrZero = [](react::Float value) { return std::isnan(value) ? 0 : value; };
+    TextStyleKey key{
+        .fontSize = valueOrZero(textAttributes.fontSize),
+        .fontWeight = textAttributes.fontWeight.has_value() ? int(textAttributes.fontWeight.value()) : 0,
+        .isItalic = textAttributes.fontStyle == react::FontStyle::Italic,
+        .letterSpacing = valueOrZero(textAttributes.letterSpacing),
+        .lineHeight = valueOrZero(textAttributes.lineHeight),
+        .fontFamily = textAttributes.fontFamily,
+    };
+    if (auto it = m_textStyleByKey.find(key); it != m_textStyleByKey.end()) {
+        return it->second;
+    }
+    auto textStyle = OH_Drawing_CreateTextStyle();
+    if (key.fontSize) {
+        OH_Drawing_SetTextStyleFontSize(textStyle, key.fontSize);
+    }
+    if (!key.fontFamily.empty()) {
+        const char *fontFamilies[] = {key.fontFamily.c_str()};
+        OH_Drawing_SetTextStyleFontFamilies(textStyle, 1, fontFamilies);
+    }
+    if (key.fontWeight) {
+        OH_Drawing_SetTextStyleFontWeight(textStyle, mapValueToFontWeight(key.fontWeight));
+    }
+    if (key.isItalic) {
+        OH_Drawing_SetTextStyleFontStyle(textStyle, OH_Drawing_FontStyle::FONT_STYLE_ITALIC);
+    }
+    if (key.letterSpacing) {
+        OH_Drawing_SetTextStyleLetterSpacing(textStyle, key.letterSpacing);
+    }
+    if (key.lineHeight && key.fontSize) {
+        // NOTE: OH_Drawing expects the line height as a multiple of the font size
+        OH_Drawing_SetTextStyleFontHeight(textStyle, key.lineHeight / key.fontSize);
+    }
+    m_textStyleByKey.emplace(std::move(key), textStyle);
+    return textStyle;
+}
+
+void OHOSTextMeasurer::maybeClearStyles() {
+    if (m_textStyleByKey.size() + m_typographyStyleByMaxLines.size() >= MAX_CACHED_STYLES_COUNT) {
+        clearStyles();
+    }
+}
+
+void OHOSTextMeasurer::clearStyles() {
+    for (auto &[_key, textStyle] : m_textStyleByKey) {
+        OH_Drawing_DestroyTextStyle(textStyle);
+    }
+    m_textStyleByKey.clear();
+    for (auto &[_key, typographyStyle] : m_typographyStyleByMaxLines) {
+        OH_Drawing_DestroyTypographyStyle(typographyStyle);
+    }
+    m_typographyStyleByMaxLines.clear();
+}
+
+bool OHOSTextMeasurer::TextStyleKey::operator==(TextStyleKey const &other) const {
+    return fontSize == other.fontSize && fontWeight == other.fontWeight && isItalic == other.isItalic &&
+           letterSpacing == other.letterSpacing && lineHeight == other.lineHeight && fontFamily == other.fontFamily;
+}
+
+size_t OHOSTextMeasurer::TextStyleKeyHash::operator()(TextStyleKey const &key) const {
+    auto hash = std::hash<react::Float>{}(key.fontSize);
+    hash = hash * 31 + std::hash<int>{}(key.fontWeight);
+    hash = hash * 31 + std::hash<bool>{}(key.isItalic);
+    hash = hash * 31 + std::hash<react::Float>{}(key.letterSpacing);
+    hash = hash * 31 + std::hash<react::Float>{}(key.lineHeight);
+    hash = hash * 31 + std::hash<std::string>{}(key.fontFamily);
+    return hash;
+}
+
+OH_Drawing_FontWeight OHOSTextMeasurer::mapValueToFontWeight(int value) {
+    switch (value) {
+    case 100:
+        return OH_Drawing_FontWeight::FONT_WEIGHT_100;
+    case 200:
+        return OH_Drawing_FontWeight::FONT_WEIGHT_200;
+    case 300:
+        return OH_Drawing_FontWeight::FONT_WEIGHT_300;
+    case 400:
+        return OH_Drawing_FontWeight::FONT_WEIGHT_400;
+    case 500:
+        return OH_Drawing_FontWeight::FONT_WEIGHT_500;
+    case 600:
+        return OH_Drawing_FontWeight::FONT_WEIGHT_600;
+    case 700:
+        return OH_Drawing_FontWeight::FONT_WEIGHT_700;
+    case 800:
+        return OH_Drawing_FontWeight::FONT_WEIGHT_800;
+    case 900:
+        return OH_Drawing_FontWeight::FONT_WEIGHT_900;
+    default:
+        return OH_Drawing_FontWeight::FONT_WEIGHT_400;
+    }
+}
@@ -1,94 +1,143 @@
 #pragma once
+#include <react/renderer/attributedstring/AttributedString.h>
+#include <react/renderer/attributedstring/ParagraphAttributes.h>
+#include <react/renderer/core/LayoutConstraints.h>
 #include <react/renderer/graphics/Float.h>
+#include <react/renderer/textlayoutmanager/TextMeasureCache.h>
 #include <native_drawing/drawing_text_typography.h>
 #include <native_drawing/drawing_font_collection.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 
 namespace rnoh {
 
+/**
+ * Thread-safe. The font collection is created once per measurer, and typography/text styles are reused
+ * between measurements with the same attributes.
+ */
 class OHOSTextMeasurer {
+  public:
+    using Shared = std::shared_ptr<OHOSTextMeasurer>;
+
+    OHOSTextMeasurer() : m_fontCollection(OH_Drawing_CreateFontCollection()) {}
+
+    ~OHOSTextMeasurer() {
+        clearStyles();
+        OH_Drawing_DestroyFontCollection(m_fontCollection);
+    }
+
+    OHOSTextMeasurer(const OHOSTextMeasurer &) = delete;
+    OHOSTextMeasurer &operator=(const OHOSTextMeasurer &) = delete;
+
+    /**
+     * Laid-out typography of a paragraph, returned to RN as the host text storage, so that subsequent measurements of
+     * the same paragraph don't need to shape the text again.
+     */
+    class TextStorage;
+
+    /**
+     * Measures all fragments in a single paragraph. Attachments are laid out as placeholders sized by their shadow
+     * views, and their frames are returned in the fragments order.
+     */
+    facebook::react::TextMeasurement measure(facebook::react::AttributedString const &attributedString,
+                                             facebook::react::ParagraphAttributes const &paragraphAttributes,
+                                             facebook::react::LayoutConstraints const &layoutConstraints);
+
+    /**
+     * Reuses the typography from `textStorage` if it was created for an equivalent attributed string. Otherwise,
+     * creates the typography and stores it in `textStorage`.
+     */
+    facebook::react::TextMeasurement measure(facebook::react::AttributedString const &attributedString,
+                                             facebook::react::ParagraphAttributes const &paragraphAttributes,
+                                             facebook::react::LayoutConstraints const &layoutConstraints,
+                                             std::shared_ptr<TextStorage> const &textStorage);
+
+    /**
+     * The storage is empty until it is passed to `measure`, so creating it is cheap when the measurement is cached.
+     */
+    std::shared_ptr<TextStorage> createTextStorage();
+
+    /**
+     * Reads line metrics from the typography of a living text storage for this paragraph, if there is one.
+     */
+    facebook::react::LinesMeasurements measureLines(facebook::react::AttributedString const &attributedString,
+                                                    facebook::react::ParagraphAttributes const &paragraphAttributes,
+                                                    facebook::react::Size const &size);
+
+    static OH_Drawing_FontWeight mapValueToFontWeight(int value);
 
   private:
-    OH_Drawing_FontCollection *fontCollection;
-    OH_Drawing_TypographyStyle *typographyStyle;
+    struct TypographyDeleter {
+        void operator()(OH_Drawing_Typography *typography) const {
+            OH_Drawing_DestroyTypography(typography);
+        }
+    };
 
-  public:
-    struct Size {
-        facebook::react::Float width;
-        facebook::react::Float height;
+    struct Typography {
+        std::unique_ptr<OH_Drawing_Typography, TypographyDeleter> typography;
+        size_t attachmentsCount;
+        facebook::react::Float layoutWidth;
     };
 
-    struct Config {
-        facebook::react::Float containerWidth;
+    struct TextStyleKey {
         facebook::react::Float fontSize;
         int fontWeight;
+        bool isItalic;
+        facebook::react::Float letterSpacing;
         facebook::react::Float lineHeight;
         std::string fontFamily;
-        int maximumNumberOfLines;
+
+        bool operator==(TextStyleKey const &other) const;
     };
 
-    OHOSTextMeasurer() {
-        this->fontCollection = OH_Drawing_CreateFontCollection();
-    }
+    struct TextStyleKeyHash {
+        size_t operator()(TextStyleKey const &key) const;
+    };
 
-    ~OHOSTextMeasurer() {
-        OH_Drawing_DestroyFontCollection(this->fontCollection);
-    }
+    // NOTE: styles are small, but the number of distinct font attributes is unbounded in theory
+    static constexpr size_t MAX_CACHED_STYLES_COUNT = 256;
+    // NOTE: storages are owned by paragraphs, this only limits how many of them measureLines can find
+    static constexpr size_t MAX_TRACKED_TEXT_STORAGES_COUNT = 1024;
 
-    Size measureText(std::string text, Config config) {
-        auto typographyStyle = OH_Drawing_CreateTypographyStyle();
-        if (config.maximumNumberOfLines) {
-            OH_Drawing_SetTypographyTextMaxLines(typographyStyle, config.maximumNumberOfLines);
-        }
-        auto typographyHandler = OH_Drawing_CreateTypographyHandler(typographyStyle, fontCollection);
-        auto textStyle = OH_Drawing_CreateTextStyle();
-        if (config.fontSize) {
-            OH_Drawing_SetTextStyleFontSize(textStyle, config.fontSize);
-        }
-        if (!config.fontFamily.empty()) {
-            const char *fontFamilies[] = {config.fontFamily.c_str()};
-            OH_Drawing_SetTextStyleFontFamilies(textStyle, 1, fontFamilies);
-        }
-        if (config.fontWeight) {
-            OH_Drawing_SetTextStyleFontWeight(textStyle, this->mapValueToFontWeight(config.fontWeight));
-        }
-        OH_Drawing_TypographyHandlerPushTextStyle(typographyHandler, textStyle);
-        OH_Drawing_TypographyHandlerAddText(typographyHandler, text.c_str());
-        auto typography = OH_Drawing_CreateTypography(typographyHandler);
-        OH_Drawing_TypographyLayout(typography, config.containerWidth ? config.containerWidth : std::numeric_limits<facebook::react::Float>::max());
-        auto height = OH_Drawing_TypographyGetHeight(typography);
-        auto longestLineWidth = OH_Drawing_TypographyGetLongestLine(typography);
-        OH_Drawing_DestroyTextStyle(textStyle);
-        OH_Drawing_DestroyTypography(typography);
-        OH_Drawing_DestroyTypographyHandler(typographyHandler);
-        OH_Drawing_DestroyTypographyStyle(typographyStyle);
-        Size size{.width = longestLineWidth + 0.5 /* fixes unexpected wrap */, .height = height};
-        return size;
-    }
+    /**
+     * Must be called with m_mutex locked.
+     */
+    Typography createTypography(facebook::react::AttributedString const &attributedString,
+                                facebook::react::ParagraphAttributes const &paragraphAttributes,
+                                facebook::react::Float maxWidth);
+    static void layout(Typography &typography, facebook::react::Float maxWidth);
+    static facebook::react::TextMeasurement measure(Typography &typography);
+    static facebook::react::LinesMeasurements measureLines(Typography &typography, std::string const &text);
+    OH_Drawing_TypographyStyle *getTypographyStyle(int maximumNumberOfLines);
+    OH_Drawing_TextStyle *getTextStyle(facebook::react::TextAttributes const &textAttributes);
+    void maybeClearStyles();
+    void clearStyles();
+    /**
+     * Must be called with m_mutex locked.
+     */
+    void trackTextStorage(std::shared_ptr<TextStorage> const &textStorage, std::optional<size_t> previousHash);
 
-    OH_Drawing_FontWeight mapValueToFontWeight(int value) {
-        switch (value) {
-        case 100:
-            return OH_Drawing_FontWeight::FONT_WEIGHT_100;
-        case 200:
-            return OH_Drawing_FontWeight::FONT_WEIGHT_200;
-        case 300:
-            return OH_Drawing_FontWeight::FONT_WEIGHT_300;
-        case 400:
-            return OH_Drawing_FontWeight::FONT_WEIGHT_400;
-        case 500:
-            return OH_Drawing_FontWeight::FONT_WEIGHT_500;
-        case 600:
-            return OH_Drawing_FontWeight::FONT_WEIGHT_600;
-        case 700:
-            return OH_Drawing_FontWeight::FONT_WEIGHT_700;
-        case 800:
-            return OH_Drawing_FontWeight::FONT_WEIGHT_800;
-        case 900:
-            return OH_Drawing_FontWeight::FONT_WEIGHT_900;
-        default:
-            return OH_Drawing_FontWeight::FONT_WEIGHT_400;
-        }
-    }
+    std::mutex m_mutex;
+    OH_Drawing_FontCollection *m_fontCollection;
+    std::unordered_map<TextStyleKey, OH_Drawing_TextStyle *, TextStyleKeyHash> m_textStyleByKey;
+    std::unordered_map<int, OH_Drawing_TypographyStyle *> m_typographyStyleByMaxLines;
+    std::unordered_multimap<size_t, std::weak_ptr<TextStorage>> m_textStoragesByHash;
+    size_t m_textStoragesCountAfterLastPrune = 0;
+};
+
+class OHOSTextMeasurer::TextStorage {
+  private:
+    friend class OHOSTextMeasurer;
+
+    std::mutex m_mutex;
+    facebook::react::AttributedString m_attributedString;
+    facebook::react::ParagraphAttributes m_paragraphAttributes;
+    std::optional<Typography> m_typography;
+    // NOTE: key under which the storage is tracked in m_textStoragesByHash, valid once m_typography is set
+    size_t m_hash = 0;
 };
 } // namespace rnoh
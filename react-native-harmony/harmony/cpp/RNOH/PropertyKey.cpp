@@ -0,0 +1,115 @@
+#include "PropertyKey.h"
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace rnoh {
+
+namespace {
+
+class PropertyKeyRegistry {
+  public:
+    static PropertyKeyRegistry &getInstance() {
+        static PropertyKeyRegistry registry;
+        return registry;
+    }
+
+    uint32_t intern(std::string const &name) {
+        std::lock_guard lock(m_mtx);
+        auto it = m_idByName.find(name);
+        if (it != m_idByName.end()) {
+            return it->second;
+        }
+        auto id = static_cast<uint32_t>(m_names.size());
+        m_names.push_back(name);
+        m_idByName.emplace(name, id);
+        return id;
+    }
+
+    std::string const &getName(uint32_t id) {
+        std::lock_guard lock(m_mtx);
+        // NOTE: deque doesn't move its elements when growing at the end
+        return m_names[id];
+    }
+
+  private:
+    std::mutex m_mtx;
+    std::deque<std::string> m_names;
+    std::unordered_map<std::string, uint32_t> m_idByName;
+};
+
+/**
+ * napi strings of the keys used in one env, indexed by key id. Only accessed on the env's thread.
+ */
+struct EnvKeyTable {
+    std::vector<napi_ref> refById;
+};
+
+std::mutex envKeyTablesMtx;
+std::unordered_map<napi_env, std::unique_ptr<EnvKeyTable>> envKeyTableByEnv;
+// NOTE: envs are single-threaded, so a thread almost always looks up the same table
+thread_local napi_env lastEnv = nullptr;
+thread_local EnvKeyTable *lastEnvKeyTable = nullptr;
+
+void onEnvCleanup(void *arg) {
+    auto env = static_cast<napi_env>(arg);
+    if (lastEnv == env) {
+        lastEnv = nullptr;
+        lastEnvKeyTable = nullptr;
+    }
+    // NOTE: references are released with the env, a new env may reuse its address
+    std::lock_guard lock(envKeyTablesMtx);
+    envKeyTableByEnv.erase(env);
+}
+
+EnvKeyTable &getEnvKeyTable(napi_env env) {
+    if (env == lastEnv) {
+        return *lastEnvKeyTable;
+    }
+    std::lock_guard lock(envKeyTablesMtx);
+    auto &table = envKeyTableByEnv[env];
+    if (table == nullptr) {
+        table = std::make_unique<EnvKeyTable>();
+        napi_add_env_cleanup_hook(env, onEnvCleanup, env);
+    }
+    lastEnv = env;
+    lastEnvKeyTable = table.get();
+    return *table;
+}
+
+} // namespace
+
+PropertyKey PropertyKey::intern(std::string const &name) {
+    return PropertyKey(PropertyKeyRegistry::getInstance().intern(name));
+}
+
+std::string const &PropertyKey::getName() const {
+    return PropertyKeyRegistry::getInstance().getName(m_id);
+}
+
+napi_value PropertyKey::getNapiValue(napi_env env) const {
+    auto &refById = getEnvKeyTable(env).refById;
+    if (m_id >= refById.size()) {
+        refById.resize(m_id + 1, nullptr);
+    }
+    auto &ref = refById[m_id];
+    if (ref == nullptr) {
+        auto const &name = getName();
+        napi_value string;
+        if (napi_create_string_utf8(env, name.c_str(), name.length(), &string) != napi_ok ||
+            napi_create_reference(env, string, 1, &ref) != napi_ok) {
+            ref = nullptr;
+            throw std::runtime_error("Failed to create property key: " + name);
+        }
+    }
+    napi_value result;
+    if (napi_get_reference_value(env, ref, &result) != napi_ok) {
+        throw std::runtime_error("Failed to get property key: " + getName());
+    }
+    return result;
+}
+
+} // namespace rnoh
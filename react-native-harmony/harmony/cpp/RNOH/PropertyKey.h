@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <napi/native_api.h>
+
+namespace rnoh {
+
+/**
+ * Handle to an interned property name. Reading a property by PropertyKey reuses a napi string created once per
+ * napi_env and kept alive by a napi_ref, instead of creating a new string on every lookup.
+ *
+ * Keys are process-wide and can be interned on any thread. Binders should intern the keys they read once, e.g.:
+ *     static auto const CONTENT_OFFSET_X_KEY = rnoh::PropertyKey::intern("contentOffsetX");
+ */
+class PropertyKey {
+  public:
+    /**
+     * Returns the same key for the same name.
+     */
+    static PropertyKey intern(std::string const &name);
+
+    std::string const &getName() const;
+
+    /**
+     * Must be called on the thread of `env`. The napi string is created on the first call for the given env.
+     */
+    napi_value getNapiValue(napi_env env) const;
+
+    bool operator==(PropertyKey const &other) const {
+        return m_id == other.m_id;
+    }
+
+  private:
+    explicit PropertyKey(uint32_t id) : m_id(id) {}
+
+    uint32_t m_id;
+};
+
+/**
+ * Keys read by the core event and state decoders.
+ */
+namespace PropertyKeys {
+inline PropertyKey const CHANGED_TOUCHES = PropertyKey::intern("changedTouches");
+inline PropertyKey const CONTAINER_SIZE = PropertyKey::intern("containerSize");
+inline PropertyKey const CONTENT_OFFSET = PropertyKey::intern("contentOffset");
+inline PropertyKey const CONTENT_SIZE = PropertyKey::intern("contentSize");
+inline PropertyKey const HEIGHT = PropertyKey::intern("height");
+inline PropertyKey const ID = PropertyKey::intern("id");
+inline PropertyKey const PAGE_X = PropertyKey::intern("pageX");
+inline PropertyKey const PAGE_Y = PropertyKey::intern("pageY");
+inline PropertyKey const SCREEN_X = PropertyKey::intern("screenX");
+inline PropertyKey const SCREEN_Y = PropertyKey::intern("screenY");
+inline PropertyKey const TARGET = PropertyKey::intern("target");
+inline PropertyKey const TARGET_TAG = PropertyKey::intern("targetTag");
+inline PropertyKey const TIMESTAMP = PropertyKey::intern("timestamp");
+inline PropertyKey const TOUCHES = PropertyKey::intern("touches");
+inline PropertyKey const TYPE = PropertyKey::intern("type");
+inline PropertyKey const URI = PropertyKey::intern("uri");
+inline PropertyKey const VALUE = PropertyKey::intern("value");
+inline PropertyKey const WIDTH = PropertyKey::intern("width");
+inline PropertyKey const X = PropertyKey::intern("x");
+inline PropertyKey const Y = PropertyKey::intern("y");
+inline PropertyKey const ZOOM_SCALE = PropertyKey::intern("zoomScale");
+} // namespace PropertyKeys
+
+} // namespace rnoh
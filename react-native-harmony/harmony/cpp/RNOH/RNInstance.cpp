@@ -2,6 +2,13 @@
 #include <react/renderer/componentregistry/ComponentDescriptorRegistry.h>
 #include <react/renderer/animations/LayoutAnimationDriver.h>
 #include <cxxreact/JSBundleType.h>
+#include <cxxreact/JSExecutor.h>
+#include <cxxreact/JSIndexedRAMBundle.h>
+#include <cxxreact/RAMBundleRegistry.h>
+#include <folly/MoveWrapper.h>
+#include <sys/mman.h>
+#include <cerrno>
+#include <cstring>
 #include "RNOH/MessageQueueThread.h"
 #include "RNOH/RNInstance.h"
 #include "RNOH/EventBeat.h"
@@ -22,6 +29,38 @@ void RNInstance::start() {
     this->initializeScheduler();
 }
 
+static ::hermes::vm::RuntimeConfig createHermesRuntimeConfig(HermesRuntimeConfig const &config) {
+    auto gcConfigBuilder = ::hermes::vm::GCConfig::Builder();
+    gcConfigBuilder.withShouldRecordStats(config.shouldRecordGCStats);
+    if (config.initialHeapSizeInBytes > 0) {
+        gcConfigBuilder.withInitHeapSize(config.initialHeapSizeInBytes);
+    }
+    if (config.maxHeapSizeInBytes > 0) {
+        gcConfigBuilder.withMaxHeapSize(config.maxHeapSizeInBytes);
+    }
+    switch (config.releaseUnusedMemory) {
+        case HermesRuntimeConfig::ReleaseUnusedMemory::DEFAULT:
+            break;
+        case HermesRuntimeConfig::ReleaseUnusedMemory::NONE:
+            gcConfigBuilder.withShouldReleaseUnused(::hermes::vm::kReleaseUnusedNone);
+            break;
+        case HermesRuntimeConfig::ReleaseUnusedMemory::OLD_GENERATION:
+            gcConfigBuilder.withShouldReleaseUnused(::hermes::vm::kReleaseUnusedOld);
+            break;
+        case HermesRuntimeConfig::ReleaseUnusedMemory::YOUNG_GENERATION_ON_FULL_GC:
+            gcConfigBuilder.withShouldReleaseUnused(::hermes::vm::kReleaseUnusedYoungOnFull);
+            break;
+        case HermesRuntimeConfig::ReleaseUnusedMemory::YOUNG_GENERATION_ALWAYS:
+            gcConfigBuilder.withShouldReleaseUnused(::hermes::vm::kReleaseUnusedYoungAlways);
+            break;
+    }
+    // NOTE: sample profiling is enabled as in HermesExecutorFactory::defaultRuntimeConfig
+    return ::hermes::vm::RuntimeConfig::Builder()
+        .withEnableSampleProfiling(true)
+        .withGCConfig(gcConfigBuilder.build())
+        .build();
+}
+
 void RNInstance::initialize() {
     // create a new event dispatcher every time RN is initialized
     m_eventDispatcher = std::make_shared<EventDispatcher>();
@@ -34,7 +73,9 @@ void RNInstance::initialize() {
         [](facebook::jsi::Runtime &rt) {
             // install `console.log` (etc.) implementation
             react::bindNativeLogger(rt, nativeLogger);
-        });
+        },
+        react::JSIExecutor::defaultTimeoutInvoker,
+        createHermesRuntimeConfig(m_hermesRuntimeConfig));
     auto jsQueue = std::make_shared<MessageQueueThread>(this->taskExecutor);
     auto moduleRegistry = std::make_shared<react::ModuleRegistry>(std::move(modules));
     this->instance->initializeBridge(
@@ -43,11 +84,12 @@ void RNInstance::initialize() {
         std::move(jsQueue),
         std::move(moduleRegistry));
 
-    std::make_shared<TurboModuleProvider>(
+    m_turboModuleProvider = std::make_shared<TurboModuleProvider>(
         this->instance->getJSCallInvoker(),
         std::move(m_turboModuleFactory),
-        m_eventDispatcher)
-        ->installJSBindings(this->instance->getRuntimeExecutor());
+        m_eventDispatcher,
+        this->instance);
+    m_turboModuleProvider->installJSBindings(this->instance->getRuntimeExecutor());
 }
 
 void RNInstance::initializeScheduler() {
@@ -81,8 +123,8 @@ void RNInstance::initializeScheduler() {
     this->schedulerDelegate = std::make_unique<SchedulerDelegate>(MountingManager(
                                                                       taskExecutor,
                                                                       m_shadowViewRegistry,
-                                                                      [mutationsListener = this->m_mutationsListener, mutationsToNapiConverter = this->m_mutationsToNapiConverter](react::ShadowViewMutationList mutations) {
-                                                                          mutationsListener(mutationsToNapiConverter, mutations);
+                                                                      [mutationsListener = this->m_mutationsListener, mutationsToNapiConverter = this->m_mutationsToNapiConverter](react::ShadowViewMutationList mutations, MountingManager::BinaryMutations binaryMutations) {
+                                                                          mutationsListener(mutationsToNapiConverter, mutations, std::move(binaryMutations));
                                                                       },
                                                                       [weakExecutor = std::weak_ptr(this->taskExecutor), commandDispatcher = this->m_commandDispatcher](auto tag, auto commandName, auto args) {
                                                                           if (auto taskExecutor = weakExecutor.lock()) {
@@ -90,41 +132,145 @@ void RNInstance::initializeScheduler() {
                                                                                   commandDispatcher(tag, commandName, args);
                                                                               });
                                                                           }
-                                                                      }),
+                                                                      },
+                                                                      m_mutationsTransport == MutationsTransport::BINARY
+                                                                          ? MountingManager::SerializeMutationsFn([mutationsToNapiConverter = this->m_mutationsToNapiConverter](auto const &mutations) {
+                                                                                return mutationsToNapiConverter.serialize(mutations);
+                                                                            })
+                                                                          : nullptr),
                                                                   m_arkTsChannel);
     m_animationDriver = std::make_shared<react::LayoutAnimationDriver>(
         this->instance->getRuntimeExecutor(), m_contextContainer, this);
     this->scheduler = std::make_unique<react::Scheduler>(schedulerToolbox, m_animationDriver.get(), schedulerDelegate.get());
 }
 
-void RNInstance::loadScript(std::vector<uint8_t> &&bundle, std::string const sourceURL, std::function<void(const std::string)> &&onFinish) {
-    this->taskExecutor->runTask(TaskThread::JS, [this, bundle = std::move(bundle), sourceURL, onFinish = std::move(onFinish)]() mutable {
-        std::unique_ptr<react::JSBigBufferString> jsBundle;
-        jsBundle = std::make_unique<react::JSBigBufferString>(bundle.size());
-        memcpy(jsBundle->data(), bundle.data(), bundle.size());
-
-        react::BundleHeader header;
-        memcpy(&header, bundle.data(), sizeof(react::BundleHeader));
-        react::ScriptTag scriptTag = react::parseTypeFromHeader(header);
-        // NOTE: Hermes bytecode bundles are treated as String bundles,
-        // and don't throw an error here.
-        if (scriptTag != react::ScriptTag::String) {
-            throw new std::runtime_error("RAM bundles are not yet supported");
-        }
+static react::BundleHeader readBundleHeader(react::JSBigString const &bundle) {
+    react::BundleHeader header{};
+    memcpy(&header, bundle.c_str(), std::min(bundle.size(), sizeof(react::BundleHeader)));
+    return header;
+}
+
+static std::string getErrorMessage(std::exception const &e) {
+    try {
+        std::rethrow_if_nested(e);
+        return e.what();
+    } catch (const std::exception &nested) {
+        return e.what() + std::string("\n") + nested.what();
+    }
+}
+
+static void runLoadTask(std::function<void()> const &load, std::function<void(const std::string)> const &onFinish) {
+    try {
+        load();
+        onFinish("");
+    } catch (std::exception const &e) {
+        onFinish(getErrorMessage(e));
+    }
+}
+
+// NOTE: Hermes runs bytecode from the memory it's given, but JS source must be NUL-terminated
+static std::unique_ptr<react::JSBigString const> toRunnableScript(std::unique_ptr<react::JSBigString const> bundle, react::BundleHeader const &header) {
+    if (react::isHermesBytecodeBundle(header)) {
+        return bundle;
+    }
+    auto sourceBundle = std::make_unique<react::JSBigBufferString>(bundle->size());
+    memcpy(sourceBundle->data(), bundle->c_str(), bundle->size());
+    return sourceBundle;
+}
+
+void RNInstance::loadScript(std::unique_ptr<react::JSBigString const> bundle, std::string const sourceURL, std::function<void(const std::string)> &&onFinish) {
+    this->taskExecutor->runTask(TaskThread::JS, [this, bundle = folly::makeMoveWrapper(std::move(bundle)), sourceURL, onFinish = std::move(onFinish)]() mutable {
+        runLoadTask([&] {
+            auto header = readBundleHeader(**bundle);
+            if (react::parseTypeFromHeader(header) == react::ScriptTag::RAMBundle) {
+                // NOTE: the bundle is copied into a stream, segments are still read from their files on demand
+                auto ramBundle = std::make_unique<react::JSIndexedRAMBundle>(bundle.move());
+                auto startupScript = ramBundle->getStartupCode();
+                auto bundleRegistry = react::RAMBundleRegistry::multipleBundlesRegistry(
+                    std::move(ramBundle), react::JSIndexedRAMBundle::buildFactory());
+                this->instance->loadRAMBundle(std::move(bundleRegistry), std::move(startupScript), sourceURL, true);
+                m_mainBundleScriptTag = react::ScriptTag::RAMBundle;
+                return;
+            }
+            this->loadScriptOnJSThread(bundle.move(), header, sourceURL);
+        }, onFinish);
+    });
+}
+
+void RNInstance::loadScriptFromFile(std::string const bundlePath, std::string const sourceURL, std::function<void(const std::string)> &&onFinish) {
+    this->taskExecutor->runTask(TaskThread::JS, [this, bundlePath, sourceURL, onFinish = std::move(onFinish)] {
+        runLoadTask([&] {
+            std::unique_ptr<react::JSBigString const> bundle = react::JSBigFileString::fromPath(bundlePath);
+            auto header = readBundleHeader(*bundle);
+            if (react::parseTypeFromHeader(header) == react::ScriptTag::RAMBundle) {
+                // NOTE: only the startup code is read now, modules are read from the file when first required
+                this->instance->loadRAMBundleFromFile(bundlePath, sourceURL, true);
+                m_mainBundleScriptTag = react::ScriptTag::RAMBundle;
+                return;
+            }
+            this->loadScriptOnJSThread(std::move(bundle), header, sourceURL);
+        }, onFinish);
+    });
+}
+
+void RNInstance::registerSegment(uint32_t segmentId, std::string const segmentPath, std::function<void(const std::string)> &&onFinish) {
+    this->taskExecutor->runTask(TaskThread::JS, [this, segmentId, segmentPath, onFinish = std::move(onFinish)] {
         try {
-            this->instance->loadScriptFromString(std::move(jsBundle), sourceURL, true);
-            onFinish("");
-        } catch (std::exception const &e) {
-            try {
-                std::rethrow_if_nested(e);
-                onFinish(e.what());
-            } catch (const std::exception &nested) {
-                onFinish(e.what() + std::string("\n") + nested.what());
+            if (!m_mainBundleScriptTag.has_value()) {
+                throw std::runtime_error("Segments can be registered only after the main bundle is loaded");
+            }
+            std::unique_ptr<react::JSBigString const> segment = react::JSBigFileString::fromPath(segmentPath);
+            auto header = readBundleHeader(*segment);
+            auto isRAMSegment = react::parseTypeFromHeader(header) == react::ScriptTag::RAMBundle;
+            auto isRAMMainBundle = m_mainBundleScriptTag.value() == react::ScriptTag::RAMBundle;
+            if (isRAMSegment != isRAMMainBundle) {
+                throw std::runtime_error(
+                    "Segment " + std::to_string(segmentId) +
+                    (isRAMSegment ? " is an indexed RAM bundle, but the main bundle isn't" : " isn't an indexed RAM bundle, but the main bundle is"));
             }
+            auto runtimeExecutor = this->instance->getRuntimeExecutor();
+            if (!runtimeExecutor) {
+                throw std::runtime_error("JS runtime isn't available");
+            }
+            if (isRAMSegment) {
+                // NOTE: the executor's RAM bundle registry opens the segment when its registration task runs, and errors
+                // thrown there don't reach onFinish; opening the segment here reports a malformed one instead
+                react::JSIndexedRAMBundle ramSegment(segmentPath.c_str());
+                this->instance->registerBundle(segmentId, segmentPath);
+                // NOTE: the executor queue is FIFO, so onFinish is called once the segment is registered
+                runtimeExecutor([onFinish](jsi::Runtime &) { onFinish(""); });
+                return;
+            }
+            // NOTE: evaluated here rather than by Instance::registerBundle, so evaluation errors reach onFinish
+            runtimeExecutor([segmentId, segmentPath, onFinish, segment = folly::makeMoveWrapper(toRunnableScript(std::move(segment), header))](jsi::Runtime &runtime) mutable {
+                runLoadTask([&] {
+                    runtime.evaluateJavaScript(std::make_unique<react::BigStringBuffer>(segment.move()),
+                                               react::JSExecutor::getSyntheticBundlePath(segmentId, segmentPath));
+                }, onFinish);
+            });
+        } catch (std::exception const &e) {
+            onFinish(getErrorMessage(e));
         }
     });
 }
 
+void RNInstance::loadScriptOnJSThread(std::unique_ptr<react::JSBigString const> bundle, react::BundleHeader const &header, std::string const &sourceURL) {
+    // NOTE: Hermes bytecode bundles are treated as String bundles,
+    // and don't throw an error here.
+    auto scriptTag = react::parseTypeFromHeader(header);
+    if (scriptTag != react::ScriptTag::String) {
+        throw std::runtime_error(std::string("Unsupported bundle type: ") + react::stringForScriptTag(scriptTag));
+    }
+    bundle = toRunnableScript(std::move(bundle), header);
+    if (auto fileBundle = dynamic_cast<react::JSBigFileString const *>(bundle.get())) {
+        // NOTE: JSBigFileString::fromPath maps the file from its start, so the mapping is page-aligned
+        m_mappedBytecode = fileBundle->c_str();
+        m_mappedBytecodeSize = fileBundle->size();
+    }
+    this->instance->loadScriptFromString(std::move(bundle), sourceURL, true);
+    m_mainBundleScriptTag = scriptTag;
+}
+
 void rnoh::RNInstance::createSurface(react::Tag surfaceId, std::string const &appKey) {
     if (surfaceHandlers.count(surfaceId)) {
         LOG(ERROR) << "createSurface: Surface with surface id " << surfaceId << " already exists.";
@@ -272,6 +418,50 @@ void rnoh::RNInstance::onMemoryLevel(size_t memoryLevel) {
     if (this->instance) {
         this->instance->handleMemoryPressure(memoryLevels[memoryLevel]);
     }
+    if (auto textMeasurementCache = m_contextContainer->find<facebook::react::TextMeasurementCache::Shared>("textMeasurementCache")) {
+        textMeasurementCache.value()->onMemoryLevel(memoryLevel);
+    }
+    if (m_hermesRuntimeConfig.shouldEvictBytecodePagesOnMemoryPressure) {
+        this->taskExecutor->runTask(TaskThread::JS, [this] {
+            if (m_mappedBytecode == nullptr) {
+                return;
+            }
+            // NOTE: the mapping is private and read-only, so dropped pages are read from the file again when touched
+            if (madvise(const_cast<char *>(m_mappedBytecode), m_mappedBytecodeSize, MADV_DONTNEED) != 0) {
+                LOG(WARNING) << "Couldn't evict bytecode pages: " << std::strerror(errno);
+            }
+        });
+    }
+}
+
+void rnoh::RNInstance::getHermesHeapInfo(bool includeExpensive, std::function<void(std::unordered_map<std::string, int64_t>)> &&onResult) {
+    this->taskExecutor->runTask(TaskThread::JS, [this, includeExpensive, onResult = std::move(onResult)] {
+        auto runtime = static_cast<facebook::jsi::Runtime *>(this->instance->getJavaScriptContext());
+        if (runtime == nullptr) {
+            onResult({});
+            return;
+        }
+        onResult(runtime->instrumentation().getHeapInfo(includeExpensive));
+    });
+}
+
+std::optional<facebook::react::TextMeasurementCache::Stats> rnoh::RNInstance::getTextMeasurementCacheStats() const {
+    if (auto textMeasurementCache = m_contextContainer->find<facebook::react::TextMeasurementCache::Shared>("textMeasurementCache")) {
+        return textMeasurementCache.value()->getStats();
+    }
+    return std::nullopt;
+}
+
+std::shared_ptr<AnimationTelemetryProvider> rnoh::RNInstance::getAnimationTelemetryProvider() const {
+    if (m_turboModuleProvider == nullptr) {
+        return nullptr;
+    }
+    for (auto const &turboModule : m_turboModuleProvider->getCreatedTurboModules()) {
+        if (auto provider = std::dynamic_pointer_cast<AnimationTelemetryProvider>(turboModule)) {
+            return provider;
+        }
+    }
+    return nullptr;
 }
 
 void rnoh::RNInstance::updateState(napi_env env, std::string const &componentName, facebook::react::Tag tag, napi_value newState) {
@@ -288,16 +478,42 @@ void RNInstance::callFunction(std::string &&module, std::string &&method, folly:
     });
 }
 
+void RNInstance::onForeground() {
+    this->taskExecutor->runTask(TaskThread::JS, [weakTurboModuleProvider = std::weak_ptr(m_turboModuleProvider)] {
+        if (auto turboModuleProvider = weakTurboModuleProvider.lock()) {
+            turboModuleProvider->onForeground();
+        }
+    });
+}
+
+void RNInstance::onBackground() {
+    this->taskExecutor->runTask(TaskThread::JS, [weakTurboModuleProvider = std::weak_ptr(m_turboModuleProvider)] {
+        if (auto turboModuleProvider = weakTurboModuleProvider.lock()) {
+            turboModuleProvider->onBackground();
+        }
+    });
+}
+
 void RNInstance::onAnimationStarted() {
-    m_shouldRelayUITick.store(true);
+    std::lock_guard lock(m_uiTickSubscriptionMutex);
+    if (this->unsubscribeUITickListener != nullptr) {
+        return;
+    }
+    this->unsubscribeUITickListener = this->m_frameClock->subscribe(FrameClockPhase::LAYOUT_ANIMATION, [this](auto const &) {
+        this->taskExecutor->runTask(
+            TaskThread::MAIN, [this]() { this->onUITick(); }, TaskPriority::ANIMATION);
+    });
 }
 
 void RNInstance::onAllAnimationsComplete() {
-    m_shouldRelayUITick.store(false);
+    std::lock_guard lock(m_uiTickSubscriptionMutex);
+    if (this->unsubscribeUITickListener != nullptr) {
+        this->unsubscribeUITickListener();
+        this->unsubscribeUITickListener = nullptr;
+    }
 }
 
 void RNInstance::onUITick() {
-    if (this->m_shouldRelayUITick.load()) {
-        this->scheduler->animationTick();
-    }
+    // NOTE: a tick posted before the animations completed is a no-op for the scheduler
+    this->scheduler->animationTick();
 }
@@ -4,12 +4,17 @@
 #include <utility>
 #include <thread>
 #include <functional>
+#include <optional>
 #include <napi/native_api.h>
 #include <js_native_api.h>
 #include <js_native_api_types.h>
 #include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 #include <cxxreact/Instance.h>
+#include <cxxreact/JSBigString.h>
+#include <cxxreact/JSBundleType.h>
 #include <cxxreact/ModuleRegistry.h>
 #include <cxxreact/NativeModule.h>
 #include <folly/dynamic.h>
@@ -17,21 +22,29 @@
 #include <react/renderer/animations/LayoutAnimationDriver.h>
 #include <react/renderer/uimanager/LayoutAnimationStatusDelegate.h>
 #include <react/renderer/componentregistry/ComponentDescriptorProviderRegistry.h>
+#include <react/renderer/textlayoutmanager/TextMeasurementCache.h>
 #include <ReactCommon/LongLivedObject.h>
 
 #include "RNOH/MessageQueueThread.h"
 #include "RNOH/SchedulerDelegate.h"
 #include "RNOH/ShadowViewRegistry.h"
 #include "RNOH/TurboModuleFactory.h"
+#include "RNOH/TurboModuleProvider.h"
+#include "RNOH/AnimationTelemetry.h"
 #include "RNOH/EventDispatcher.h"
 #include "RNOH/EventEmitRequestHandler.h"
 #include "RNOH/TaskExecutor/TaskExecutor.h"
-#include "RNOH/UITicker.h"
+#include "RNOH/FrameClock.h"
 #include "RNOH/ArkTSChannel.h"
+#include "RNOH/HermesRuntimeConfig.h"
 namespace rnoh {
+/**
+ * `binaryMutations` is provided only when the instance uses MutationsTransport::BINARY.
+ */
 using MutationsListener = std::function<void(
     MutationsToNapiConverter,
-    facebook::react::ShadowViewMutationList const &mutations)>;
+    facebook::react::ShadowViewMutationList const &mutations,
+    MountingManager::BinaryMutations binaryMutations)>;
 
 class RNInstance : public facebook::react::LayoutAnimationStatusDelegate {
   public:
@@ -45,8 +58,10 @@ class RNInstance : public facebook::react::LayoutAnimationStatusDelegate {
                MutationsListener &&mutationsListener,
                MountingManager::CommandDispatcher &&commandDispatcher,
                ArkTSChannel::Shared arkTsChannel,
-               UITicker::Shared uiTicker,
-               ShadowViewRegistry::Shared shadowViewRegistry)
+               FrameClock::Shared frameClock,
+               ShadowViewRegistry::Shared shadowViewRegistry,
+               MutationsTransport mutationsTransport = MutationsTransport::OBJECTS,
+               HermesRuntimeConfig hermesRuntimeConfig = {})
         : m_id(id),
           instance(std::make_shared<facebook::react::Instance>()),
           m_contextContainer(contextContainer),
@@ -57,21 +72,20 @@ class RNInstance : public facebook::react::LayoutAnimationStatusDelegate {
           m_componentDescriptorProviderRegistry(componentDescriptorProviderRegistry),
           m_mutationsToNapiConverter(mutationsToNapiConverter),
           m_eventEmitRequestHandlers(eventEmitRequestHandlers),
-          m_shouldRelayUITick(false),
           m_mutationsListener(mutationsListener),
           m_commandDispatcher(commandDispatcher),
           m_arkTsChannel(arkTsChannel),
-          m_uiTicker(uiTicker) {
-        this->unsubscribeUITickListener = this->m_uiTicker->subscribe(m_id, [this]() {
-            this->taskExecutor->runTask(TaskThread::MAIN, [this]() {
-                this->onUITick();
-            });
-        });
-    }
+          m_frameClock(std::move(frameClock)),
+          m_mutationsTransport(mutationsTransport),
+          m_hermesRuntimeConfig(hermesRuntimeConfig) {}
 
     ~RNInstance() {
-        if (this->unsubscribeUITickListener != nullptr) {
-            unsubscribeUITickListener();
+        {
+            std::lock_guard lock(m_uiTickSubscriptionMutex);
+            if (this->unsubscribeUITickListener != nullptr) {
+                unsubscribeUITickListener();
+                unsubscribeUITickListener = nullptr;
+            }
         }
         for (auto surfaceHandle : this->surfaceHandlers) {
             surfaceHandle.second->stop();
@@ -80,7 +94,21 @@ class RNInstance : public facebook::react::LayoutAnimationStatusDelegate {
     }
 
     void start();
-    void loadScript(std::vector<uint8_t> &&bundle, std::string const sourceURL, std::function<void(const std::string)> &&onFinish);
+    /**
+     * Hermes bytecode bundles are run straight from `bundle`, other bundles are copied into a NUL-terminated buffer.
+     */
+    void loadScript(std::unique_ptr<facebook::react::JSBigString const> bundle, std::string const sourceURL, std::function<void(const std::string)> &&onFinish);
+    /**
+     * Hermes bytecode bundles are memory-mapped, so their pages are shared with the page cache and loaded on demand.
+     */
+    void loadScriptFromFile(std::string const bundlePath, std::string const sourceURL, std::function<void(const std::string)> &&onFinish);
+    /**
+     * Makes a segment bundle available to the loaded main bundle. Segments must be of the main bundle's kind: modules
+     * of indexed RAM segments (RAM main bundle) are evaluated when they're first required, other segments are evaluated
+     * right away. `onFinish` is called with an error message if the segment doesn't match the main bundle, can't be
+     * read or fails to evaluate, and with an empty string once the segment is registered.
+     */
+    void registerSegment(uint32_t segmentId, std::string const segmentPath, std::function<void(const std::string)> &&onFinish);
     void createSurface(facebook::react::Tag surfaceId, std::string const &moduleName);
     void updateSurfaceConstraints(facebook::react::Tag surfaceId, float width, float height, float viewportOffsetX, float viewportOffsetY, float pixelRatio);
     void startSurface(facebook::react::Tag surfaceId, float width, float height, float viewportOffsetX, float viewportOffsetY, float pixelRatio, folly::dynamic &&initialProps);
@@ -91,6 +119,22 @@ class RNInstance : public facebook::react::LayoutAnimationStatusDelegate {
     void callFunction(std::string &&module, std::string &&method, folly::dynamic &&params);
     void emitComponentEvent(napi_env env, facebook::react::Tag tag, std::string eventName, napi_value payload);
     void onMemoryLevel(size_t memoryLevel);
+    /**
+     * JS timers that fire while the app is in background are called once it's back in foreground.
+     */
+    void onForeground();
+    void onBackground();
+    std::optional<facebook::react::TextMeasurementCache::Stats> getTextMeasurementCacheStats() const;
+    /**
+     * Returns nullptr if native Animated hasn't been used yet. The provider can be queried after the instance is
+     * destroyed.
+     */
+    std::shared_ptr<AnimationTelemetryProvider> getAnimationTelemetryProvider() const;
+    /**
+     * Calls `onResult` on the JS thread with the heap statistics Hermes reports, e.g. "hermes_heapSize".
+     * `includeExpensive` adds statistics that require walking the heap.
+     */
+    void getHermesHeapInfo(bool includeExpensive, std::function<void(std::unordered_map<std::string, int64_t>)> &&onResult);
     void updateState(napi_env env, std::string const &componentName, facebook::react::Tag tag, napi_value newState);
 
     std::shared_ptr<TaskExecutor> taskExecutor;
@@ -107,17 +151,27 @@ class RNInstance : public facebook::react::LayoutAnimationStatusDelegate {
     std::shared_ptr<facebook::react::ComponentDescriptorProviderRegistry> m_componentDescriptorProviderRegistry;
     ShadowViewRegistry::Shared m_shadowViewRegistry;
     TurboModuleFactory m_turboModuleFactory;
+    std::shared_ptr<TurboModuleProvider> m_turboModuleProvider;
     std::shared_ptr<EventDispatcher> m_eventDispatcher;
     MutationsToNapiConverter m_mutationsToNapiConverter;
+    MutationsTransport m_mutationsTransport;
     EventEmitRequestHandlers m_eventEmitRequestHandlers;
     std::shared_ptr<facebook::react::LayoutAnimationDriver> m_animationDriver;
-    UITicker::Shared m_uiTicker;
+    FrameClock::Shared m_frameClock;
+    // NOTE: frames are subscribed to only while layout animations are running
     std::function<void()> unsubscribeUITickListener = nullptr;
-    std::atomic<bool> m_shouldRelayUITick;
+    std::mutex m_uiTickSubscriptionMutex;
     ArkTSChannel::Shared m_arkTsChannel;
+    HermesRuntimeConfig m_hermesRuntimeConfig;
+    // NOTE: the memory-mapped bytecode bundle Hermes runs from, accessed on the JS thread
+    char const *m_mappedBytecode = nullptr;
+    size_t m_mappedBytecodeSize = 0;
+    // NOTE: set once the main bundle is loaded, accessed on the JS thread
+    std::optional<facebook::react::ScriptTag> m_mainBundleScriptTag;
 
     void initialize();
     void initializeScheduler();
+    void loadScriptOnJSThread(std::unique_ptr<facebook::react::JSBigString const> bundle, facebook::react::BundleHeader const &header, std::string const &sourceURL);
     void onUITick();
 
     virtual void onAnimationStarted() override;      // react::LayoutAnimationStatusDelegate
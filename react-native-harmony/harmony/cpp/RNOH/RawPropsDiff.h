@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <folly/dynamic.h>
+#include <react/renderer/core/ShadowView.h>
+
+namespace rnoh {
+
+struct RawPropsDiff {
+    folly::dynamic changedProps = folly::dynamic::object();
+    std::vector<std::string> removedPropNames;
+
+    static RawPropsDiff create(facebook::react::ShadowView const &oldShadowView, facebook::react::ShadowView const &newShadowView) {
+        RawPropsDiff diff;
+        if (newShadowView.props == nullptr) {
+            return diff;
+        }
+        if (oldShadowView.props == nullptr) {
+            diff.changedProps = newShadowView.props->rawProps;
+            return diff;
+        }
+        if (oldShadowView.props == newShadowView.props) {
+            return diff;
+        }
+        auto const &oldRawProps = oldShadowView.props->rawProps;
+        auto const &newRawProps = newShadowView.props->rawProps;
+        if (!oldRawProps.isObject() || !newRawProps.isObject()) {
+            diff.changedProps = newRawProps;
+            return diff;
+        }
+        for (auto const &[key, value] : newRawProps.items()) {
+            auto oldValue = oldRawProps.get_ptr(key);
+            if (oldValue == nullptr || *oldValue != value) {
+                diff.changedProps.insert(key, value);
+            }
+        }
+        for (auto const &[key, _value] : oldRawProps.items()) {
+            if (newRawProps.get_ptr(key) == nullptr) {
+                diff.removedPropNames.push_back(key.asString());
+            }
+        }
+        return diff;
+    }
+
+    static bool didLayoutMetricsChange(facebook::react::ShadowView const &oldShadowView, facebook::react::ShadowView const &newShadowView) {
+        return oldShadowView.layoutMetrics.frame != newShadowView.layoutMetrics.frame ||
+               oldShadowView.layoutMetrics.layoutDirection != newShadowView.layoutMetrics.layoutDirection;
+    }
+};
+
+} // namespace rnoh
@@ -1,15 +1,51 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
+#include <stdexcept>
+#include <vector>
+#include "TaskLanes.h"
+#include "TimerWheel.h"
+#include "UniqueTask.h"
 
 class AbstractTaskRunner {
 public:
-    using Task = std::function<void()>;
+    using Task = rnoh::UniqueTask;
 
     virtual void runAsyncTask(Task &&task) = 0;
+    /**
+     * Runners without priority lanes ignore `priority`.
+     */
+    virtual void runAsyncTask(Task &&task, rnoh::TaskPriority priority) {
+        runAsyncTask(std::move(task));
+    }
     virtual void runSyncTask(Task &&task) = 0;
+    /**
+     * Runners without priority lanes ignore `priority`.
+     */
+    virtual void runSyncTask(Task &&task, rnoh::TaskPriority priority) {
+        runSyncTask(std::move(task));
+    }
+
+    /**
+     * Runs `task` on the runner's thread once `deadline` passes. Must be called on the runner's thread.
+     */
+    virtual rnoh::TimerId runDelayedTask(Task &&task, std::chrono::steady_clock::time_point deadline) {
+        throw std::runtime_error("Delayed tasks aren't supported by this task runner");
+    }
+
+    /**
+     * Returns false if the task already ran or was cancelled. Must be called on the runner's thread.
+     */
+    virtual bool cancelDelayedTask(rnoh::TimerId timerId) {
+        throw std::runtime_error("Delayed tasks aren't supported by this task runner");
+    }
 
     virtual bool isOnCurrentThread() const = 0;
 
+    virtual std::vector<rnoh::TaskLaneStats> getTaskLaneStats() const {
+        return {};
+    }
+
     virtual ~AbstractTaskRunner() = default;
 };
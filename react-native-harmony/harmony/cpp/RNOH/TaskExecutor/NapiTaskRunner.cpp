@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <atomic>
 #include <uv.h>
 #include <napi/native_api.h>
@@ -7,76 +8,103 @@
 
 namespace rnoh {
 
-NapiTaskRunner::NapiTaskRunner(napi_env env) : env(env) {
+NapiTaskRunner::NapiTaskRunner(napi_env env, FrameDeadlineProvider frameDeadlineProvider)
+    : env(env), taskLanes(std::move(frameDeadlineProvider)) {
     // NOTE: let's hope the JS runtime doesn't move between system threads...
     threadId = std::this_thread::get_id();
     auto loop = getLoop();
     asyncHandle.data = static_cast<void *>(this);
     uv_async_init(loop, &asyncHandle, [](auto handle) {
         auto runner = static_cast<NapiTaskRunner *>(handle->data);
-
-        // https://nodejs.org/api/n-api.html#napi_handle_scope
-        // "For any invocations of code outside the execution of a native method (...)
-        // the module is required to create a scope before invoking any functions
-        // that can result in the creation of JavaScript values"
-        napi_handle_scope scope;
-        auto result = napi_open_handle_scope(runner->env, &scope);
-        if (result != napi_ok) {
-            LOG(ERROR) << "Failed to open handle scope";
-            return;
-        }
-
-        std::queue<Task> tasksQueue;
-        {
-            std::unique_lock<std::mutex> lock(runner->tasksMutex);
-            std::swap(tasksQueue, runner->tasksQueue);
-        }
-        while (!tasksQueue.empty()) {
-            auto task = std::move(tasksQueue.front());
-            tasksQueue.pop();
-            task();
-        }
-
-        result = napi_close_handle_scope(runner->env, scope);
-        if (result != napi_ok) {
-            LOG(ERROR) << "Failed to close handle scope";
-            return;
-        }
+        runner->runPendingTasks();
     });
+    uv_timer_init(loop, &idleTasksRetryTimer);
+    idleTasksRetryTimer.data = static_cast<void *>(this);
+}
+
+void NapiTaskRunner::runPendingTasks() {
+    // https://nodejs.org/api/n-api.html#napi_handle_scope
+    // "For any invocations of code outside the execution of a native method (...)
+    // the module is required to create a scope before invoking any functions
+    // that can result in the creation of JavaScript values"
+    napi_handle_scope scope;
+    auto result = napi_open_handle_scope(env, &scope);
+    if (result != napi_ok) {
+        LOG(ERROR) << "Failed to open handle scope";
+        return;
+    }
+
+    // NOTE: tasks posted while running pending tasks are left for the next uv_async callback,
+    // so tasks that keep reposting themselves can't starve the event loop
+    auto tasksCount = taskLanes.getPushedTasksCount() - poppedTasksCount;
+    Task task;
+    std::optional<std::chrono::steady_clock::time_point> idleTasksRetryTime;
+    while (tasksCount > 0 && taskLanes.tryPop(task, idleTasksRetryTime)) {
+        tasksCount--;
+        poppedTasksCount++;
+        task();
+        task = nullptr;
+    }
+    if (idleTasksRetryTime.has_value()) {
+        scheduleIdleTasksRetry(idleTasksRetryTime.value());
+    }
+
+    result = napi_close_handle_scope(env, scope);
+    if (result != napi_ok) {
+        LOG(ERROR) << "Failed to close handle scope";
+        return;
+    }
+}
+
+void NapiTaskRunner::scheduleIdleTasksRetry(std::chrono::steady_clock::time_point retryTime) {
+    auto timeout = std::chrono::ceil<std::chrono::milliseconds>(retryTime - std::chrono::steady_clock::now());
+    // NOTE: restarting the timer replaces the previously scheduled retry
+    uv_timer_start(
+        &idleTasksRetryTimer,
+        [](auto handle) {
+            auto runner = static_cast<NapiTaskRunner *>(handle->data);
+            runner->runPendingTasks();
+        },
+        static_cast<uint64_t>(std::max<int64_t>(timeout.count(), 0)),
+        0);
 }
 
 NapiTaskRunner::~NapiTaskRunner() {
-    running->store(false);
-    cv.notify_all();
+    uv_close(reinterpret_cast<uv_handle_t *>(&idleTasksRetryTimer), nullptr);
     uv_close(reinterpret_cast<uv_handle_t *>(&asyncHandle), nullptr);
 }
 
 void NapiTaskRunner::runAsyncTask(Task &&task) {
-    std::unique_lock<std::mutex> lock(tasksMutex);
-    tasksQueue.push(task);
+    runAsyncTask(std::move(task), TaskPriority::NORMAL);
+}
+
+void NapiTaskRunner::runAsyncTask(Task &&task, TaskPriority priority) {
+    taskLanes.push(std::move(task), priority);
     uv_async_send(&asyncHandle);
 }
 
 void NapiTaskRunner::runSyncTask(Task &&task) {
+    runSyncTask(std::move(task), TaskPriority::NORMAL);
+}
+
+void NapiTaskRunner::runSyncTask(Task &&task, TaskPriority priority) {
     if (isOnCurrentThread()) {
         task();
         return;
     }
-    std::unique_lock<std::mutex> lock(tasksMutex);
-    std::atomic_bool done{false};
-    tasksQueue.push([this, &done, task = std::move(task)]() {
-        task();
-        done = true;
-        cv.notify_all();
-    });
-    uv_async_send(&asyncHandle);
-    cv.wait(lock, [running = this->running, &done] { return !(running->load()) || done.load(); });
+    auto completion = std::make_shared<SyncTaskCompletion>();
+    runAsyncTask([task = std::move(task), guard = SyncTaskCompletion::Guard(completion)] { task(); }, priority);
+    completion->wait();
 }
 
 bool NapiTaskRunner::isOnCurrentThread() const {
     return threadId == std::this_thread::get_id();
 }
 
+std::vector<TaskLaneStats> NapiTaskRunner::getTaskLaneStats() const {
+    return taskLanes.getStats();
+}
+
 uv_loop_t *NapiTaskRunner::getLoop() const {
     uv_loop_t *loop = nullptr;
     napi_get_uv_event_loop(env, &loop);
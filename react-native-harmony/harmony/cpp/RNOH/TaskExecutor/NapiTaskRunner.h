@@ -2,8 +2,6 @@
 
 #include <atomic>
 #include <thread>
-#include <queue>
-#include <mutex>
 #include <functional>
 #include <napi/native_api.h>
 #include <js_native_api.h>
@@ -11,32 +9,40 @@
 #include <uv.h>
 
 #include "AbstractTaskRunner.h"
+#include "TaskLanes.h"
 
 namespace rnoh {
 
 class NapiTaskRunner : public AbstractTaskRunner  {
   public:
-    NapiTaskRunner(napi_env env);
+    NapiTaskRunner(napi_env env, FrameDeadlineProvider frameDeadlineProvider = nullptr);
     ~NapiTaskRunner() override;
 
     NapiTaskRunner(const NapiTaskRunner &) = delete;
     NapiTaskRunner &operator=(const NapiTaskRunner &) = delete;
 
     void runAsyncTask(Task &&task) override;
+    void runAsyncTask(Task &&task, TaskPriority priority) override;
     void runSyncTask(Task &&task) override;
+    void runSyncTask(Task &&task, TaskPriority priority) override;
 
     bool isOnCurrentThread() const override;
 
+    std::vector<TaskLaneStats> getTaskLaneStats() const override;
+
   private:
     napi_env env;
     uv_loop_t *getLoop() const;
 
+    void runPendingTasks();
+
+    void scheduleIdleTasksRetry(std::chrono::steady_clock::time_point retryTime);
+
     uv_async_t asyncHandle;
-    std::mutex tasksMutex;
-    std::queue<Task> tasksQueue;
+    uv_timer_t idleTasksRetryTimer;
+    TaskLanes taskLanes;
+    size_t poppedTasksCount = 0;
     std::thread::id threadId;
-    std::condition_variable cv;
-    std::shared_ptr<std::atomic_bool> running = std::make_shared<std::atomic_bool>(true);
 };
 
 } // namespace rnoh
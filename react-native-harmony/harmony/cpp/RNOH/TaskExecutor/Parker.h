@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace rnoh {
+
+inline void futexWait(std::atomic<int32_t> &word, int32_t expectedValue, timespec const *timeout = nullptr) {
+    // NOTE: returns immediately if `word` no longer holds `expectedValue`; spurious wake-ups are possible
+    syscall(SYS_futex, reinterpret_cast<int32_t *>(&word), FUTEX_WAIT_PRIVATE, expectedValue, timeout, nullptr, 0);
+}
+
+inline void futexWakeAll(std::atomic<int32_t> &word) {
+    syscall(SYS_futex, reinterpret_cast<int32_t *>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+inline void futexWakeOne(std::atomic<int32_t> &word) {
+    syscall(SYS_futex, reinterpret_cast<int32_t *>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+/**
+ * Parks a single consumer thread until another thread unparks it. `unpark` doesn't make a syscall unless the consumer
+ * is actually parked, and an `unpark` that happens before `park` makes the next `park` return immediately.
+ */
+class Parker {
+  public:
+    void park() {
+        // NOTIFIED -> EMPTY returns immediately, EMPTY -> PARKED sleeps
+        if (m_state.fetch_sub(1, std::memory_order_acquire) == NOTIFIED) {
+            return;
+        }
+        while (true) {
+            futexWait(m_state, PARKED);
+            auto expected = NOTIFIED;
+            if (m_state.compare_exchange_strong(expected, EMPTY, std::memory_order_acquire)) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * Like `park`, but returns once `deadline` passes.
+     */
+    void parkUntil(std::chrono::steady_clock::time_point deadline) {
+        if (m_state.fetch_sub(1, std::memory_order_acquire) == NOTIFIED) {
+            return;
+        }
+        while (true) {
+            auto now = std::chrono::steady_clock::now();
+            if (now < deadline) {
+                auto timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+                timespec relativeTimeout{
+                    .tv_sec = static_cast<time_t>(timeout.count() / 1'000'000'000),
+                    .tv_nsec = static_cast<long>(timeout.count() % 1'000'000'000),
+                };
+                futexWait(m_state, PARKED, &relativeTimeout);
+            }
+            auto expected = NOTIFIED;
+            if (m_state.compare_exchange_strong(expected, EMPTY, std::memory_order_acquire)) {
+                return;
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                // PARKED -> EMPTY, unless unpark happened in the meantime
+                expected = PARKED;
+                if (!m_state.compare_exchange_strong(expected, EMPTY, std::memory_order_acquire)) {
+                    m_state.store(EMPTY, std::memory_order_relaxed);
+                }
+                return;
+            }
+        }
+    }
+
+    void unpark() {
+        if (m_state.exchange(NOTIFIED, std::memory_order_release) == PARKED) {
+            futexWakeOne(m_state);
+        }
+    }
+
+  private:
+    static constexpr int32_t PARKED = -1;
+    static constexpr int32_t EMPTY = 0;
+    static constexpr int32_t NOTIFIED = 1;
+
+    std::atomic<int32_t> m_state{EMPTY};
+};
+
+} // namespace rnoh
@@ -7,23 +7,26 @@
 
 namespace rnoh {
 
-TaskExecutor::TaskExecutor(napi_env mainEnv) {
-    auto mainTaskRunner = std::make_shared<NapiTaskRunner>(mainEnv);
-    auto jsTaskRunner = std::make_shared<ThreadTaskRunner>("RNOH_JS");
+TaskExecutor::TaskExecutor(napi_env mainEnv, FrameDeadlineProvider frameDeadlineProvider) {
+    auto mainTaskRunner = std::make_shared<NapiTaskRunner>(mainEnv, frameDeadlineProvider);
+    auto jsTaskRunner = std::make_shared<ThreadTaskRunner>("RNOH_JS", frameDeadlineProvider);
     // NOTE: we merge MAIN and BG threads for now,
     // to allow for calling MAIN->BG->MAIN synchronously without deadlocks
     m_taskRunners = {
         mainTaskRunner,
         jsTaskRunner,
         mainTaskRunner};
+    for (auto &waitsOnThread : m_waitsOnThread) {
+        waitsOnThread = std::nullopt;
+    }
 }
 
-void TaskExecutor::runTask(TaskThread thread, Task &&task) {
-    m_taskRunners[thread]->runAsyncTask(std::move(task));
+void TaskExecutor::runTask(TaskThread thread, Task &&task, TaskPriority priority) {
+    m_taskRunners[thread]->runAsyncTask(std::move(task), priority);
 }
 
-void TaskExecutor::runSyncTask(TaskThread thread, Task &&task) {
-    auto waitsOnThread = m_waitsOnThread[thread];
+void TaskExecutor::runSyncTask(TaskThread thread, Task &&task, TaskPriority priority) {
+    auto waitsOnThread = m_waitsOnThread[thread].load();
     if (waitsOnThread.has_value() && isOnTaskThread(waitsOnThread.value())) {
         throw std::runtime_error("Deadlock detected");
     }
@@ -31,16 +34,28 @@ void TaskExecutor::runSyncTask(TaskThread thread, Task &&task) {
     if (currentThread.has_value()) {
         m_waitsOnThread[currentThread.value()] = thread;
     }
-    m_taskRunners[thread]->runSyncTask(std::move(task));
+    m_taskRunners[thread]->runSyncTask(std::move(task), priority);
     if (currentThread.has_value()) {
         m_waitsOnThread[currentThread.value()] = std::nullopt;
     }
 }
 
+TimerId TaskExecutor::runDelayedTask(TaskThread thread, Task &&task, std::chrono::steady_clock::time_point deadline) {
+    return m_taskRunners[thread]->runDelayedTask(std::move(task), deadline);
+}
+
+bool TaskExecutor::cancelDelayedTask(TaskThread thread, TimerId timerId) {
+    return m_taskRunners[thread]->cancelDelayedTask(timerId);
+}
+
 bool TaskExecutor::isOnTaskThread(TaskThread thread) const {
     return m_taskRunners[thread]->isOnCurrentThread();
 }
 
+std::vector<TaskLaneStats> TaskExecutor::getTaskLaneStats(TaskThread thread) const {
+    return m_taskRunners[thread]->getTaskLaneStats();
+}
+
 std::optional<TaskThread> TaskExecutor::getCurrentTaskThread() const {
     if (isOnTaskThread(TaskThread::MAIN)) {
         return TaskThread::MAIN;
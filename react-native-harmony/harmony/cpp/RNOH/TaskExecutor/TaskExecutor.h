@@ -1,12 +1,16 @@
 #pragma once
 #include <array>
+#include <atomic>
 #include <memory>
 #include <optional>
+#include <vector>
 #include <napi/native_api.h>
 #include <js_native_api.h>
 #include <js_native_api_types.h>
 #include <uv.h>
 #include "AbstractTaskRunner.h"
+#include "NapiTaskRunner.h"
+#include "TaskLanes.h"
 
 namespace rnoh {
 
@@ -22,18 +26,42 @@ class TaskExecutor {
     using Shared = std::shared_ptr<TaskExecutor>;
     using Weak = std::weak_ptr<TaskExecutor>;
 
-    TaskExecutor(napi_env mainEnv);
+    /**
+     * `frameDeadlineProvider` returns the time the next frame is due. MAIN and JS threads use it to postpone
+     * IDLE tasks when the current frame has no time to spare.
+     */
+    TaskExecutor(napi_env mainEnv, FrameDeadlineProvider frameDeadlineProvider = nullptr);
 
-    void runTask(TaskThread thread, Task &&task);
-    void runSyncTask(TaskThread thread, Task &&task);
+    void runTask(TaskThread thread, Task &&task, TaskPriority priority = TaskPriority::NORMAL);
+    /**
+     * Lanes are FIFO: the task runs after every task already posted to `thread` with the same or a higher priority,
+     * so with the default NORMAL priority it observes the effects of NORMAL tasks the caller posted before.
+     * A higher priority lets it overtake queued lower-priority tasks, and it may then run before them.
+     */
+    void runSyncTask(TaskThread thread, Task &&task, TaskPriority priority = TaskPriority::NORMAL);
+
+    /**
+     * Runs `task` once `deadline` passes. Must be called on `thread`; only the JS thread supports delayed tasks.
+     */
+    TimerId runDelayedTask(TaskThread thread, Task &&task, std::chrono::steady_clock::time_point deadline);
+    bool cancelDelayedTask(TaskThread thread, TimerId timerId);
 
     bool isOnTaskThread(TaskThread thread) const;
 
     std::optional<TaskThread> getCurrentTaskThread() const;
 
+    /**
+     * Returns stats for each TaskPriority lane, or an empty vector if the thread doesn't use lanes.
+     */
+    std::vector<TaskLaneStats> getTaskLaneStats(TaskThread thread) const;
+
   private:
     std::array<std::shared_ptr<AbstractTaskRunner>, TaskThread::BACKGROUND + 1> m_taskRunners;
-    std::array<std::optional<TaskThread>, TaskThread::BACKGROUND + 1> m_waitsOnThread;
+    /**
+     * The thread each thread is synchronously waiting on. Only written by the waiting thread itself, read by the
+     * others to detect deadlocks.
+     */
+    std::array<std::atomic<std::optional<TaskThread>>, TaskThread::BACKGROUND + 1> m_waitsOnThread;
 };
 
 } // namespace rnoh
@@ -0,0 +1,64 @@
+#include <algorithm>
+#include "TaskLanes.h"
+
+namespace rnoh {
+
+void TaskLanes::push(UniqueTask &&task, TaskPriority priority) {
+    auto &lane = m_lanes[static_cast<size_t>(priority)];
+    lane.queueDepthHistogram.record(lane.depth.fetch_add(1, std::memory_order_relaxed));
+    // NOTE: counted before the task becomes visible, so a consumer never pops more tasks than were counted
+    m_pushedTasksCount.fetch_add(1, std::memory_order_acq_rel);
+    lane.queue.push(std::move(task));
+}
+
+bool TaskLanes::tryPop(UniqueTask &task, std::optional<std::chrono::steady_clock::time_point> &idleTasksRetryTime) {
+    idleTasksRetryTime = std::nullopt;
+    for (size_t i = 0; i < TASK_PRIORITIES_COUNT - 1; i++) {
+        if (tryPopFromLane(m_lanes[i], task)) {
+            return true;
+        }
+    }
+    auto &idleLane = m_lanes[static_cast<size_t>(TaskPriority::IDLE)];
+    if (idleLane.depth.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    if (m_frameDeadlineProvider != nullptr) {
+        auto frameDeadline = m_frameDeadlineProvider();
+        auto now = std::chrono::steady_clock::now();
+        if (now + MIN_IDLE_TIME > frameDeadline) {
+            // NOTE: the next frame starts at the deadline of the current one; the lower bound prevents busy-waiting
+            // if the provider returns a deadline that has already passed
+            idleTasksRetryTime = std::max(frameDeadline, now + MIN_IDLE_TIME);
+            return false;
+        }
+    }
+    return tryPopFromLane(idleLane, task);
+}
+
+bool TaskLanes::tryPopFromLane(Lane &lane, UniqueTask &task) {
+    std::optional<std::chrono::steady_clock::time_point> pushedAt;
+    if (!lane.queue.tryPop(task, pushedAt)) {
+        return false;
+    }
+    lane.depth.fetch_sub(1, std::memory_order_relaxed);
+    if (pushedAt.has_value()) {
+        auto waitTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - pushedAt.value());
+        lane.waitTimeInUsHistogram.record(static_cast<uint64_t>(std::max<int64_t>(waitTime.count(), 0)));
+    }
+    return true;
+}
+
+std::vector<TaskLaneStats> TaskLanes::getStats() const {
+    std::vector<TaskLaneStats> result;
+    result.reserve(TASK_PRIORITIES_COUNT);
+    for (auto const &lane : m_lanes) {
+        result.push_back({
+            .queueDepth = lane.depth.load(std::memory_order_relaxed),
+            .queueDepthHistogram = lane.queueDepthHistogram.getCounts(),
+            .waitTimeInUsHistogram = lane.waitTimeInUsHistogram.getCounts(),
+        });
+    }
+    return result;
+}
+
+} // namespace rnoh
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "TaskQueue.h"
+
+namespace rnoh {
+
+/**
+ * Tasks with a higher priority (lower value) are executed first. IDLE tasks are executed only when there is enough time
+ * left before the next frame deadline.
+ */
+enum class TaskPriority {
+    INPUT = 0,
+    ANIMATION,
+    MOUNT,
+    NORMAL,
+    IDLE,
+};
+
+constexpr size_t TASK_PRIORITIES_COUNT = static_cast<size_t>(TaskPriority::IDLE) + 1;
+
+using FrameDeadlineProvider = std::function<std::chrono::steady_clock::time_point()>;
+
+/**
+ * Histogram with power-of-two buckets: bucket 0 counts zeros, bucket i counts values in [2^(i-1), 2^i),
+ * the last bucket counts everything bigger.
+ */
+class Log2Histogram {
+  public:
+    static constexpr size_t BUCKETS_COUNT = 20;
+
+    void record(uint64_t value) {
+        size_t bucketIdx = 0;
+        while (value > 0 && bucketIdx < BUCKETS_COUNT - 1) {
+            value >>= 1;
+            bucketIdx++;
+        }
+        m_counts[bucketIdx].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::array<uint64_t, BUCKETS_COUNT> getCounts() const {
+        std::array<uint64_t, BUCKETS_COUNT> result;
+        for (size_t i = 0; i < BUCKETS_COUNT; i++) {
+            result[i] = m_counts[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+  private:
+    std::array<std::atomic<uint64_t>, BUCKETS_COUNT> m_counts{};
+};
+
+struct TaskLaneStats {
+    size_t queueDepth;
+    /**
+     * Number of tasks already waiting in the lane, sampled whenever a task is posted.
+     */
+    std::array<uint64_t, Log2Histogram::BUCKETS_COUNT> queueDepthHistogram;
+    /**
+     * Time between posting and starting a task, in microseconds. Sampled for every
+     * TaskQueue::PUSH_TIME_SAMPLING_INTERVAL-th task posted from a thread.
+     */
+    std::array<uint64_t, Log2Histogram::BUCKETS_COUNT> waitTimeInUsHistogram;
+};
+
+/**
+ * Multi-producer single-consumer queue with a lane per TaskPriority.
+ */
+class TaskLanes {
+  public:
+    // NOTE: IDLE tasks don't start if less than this is left until the frame deadline
+    static constexpr auto MIN_IDLE_TIME = std::chrono::milliseconds(2);
+
+    TaskLanes(FrameDeadlineProvider frameDeadlineProvider = nullptr)
+        : m_frameDeadlineProvider(std::move(frameDeadlineProvider)) {}
+
+    void push(UniqueTask &&task, TaskPriority priority);
+
+    /**
+     * Pops a task from the highest non-empty lane. Must be called only from the consumer thread.
+     * If only IDLE tasks are left and there is no slack in the current frame, returns false and sets
+     * `idleTasksRetryTime` to the time when IDLE tasks should be retried.
+     */
+    bool tryPop(UniqueTask &task, std::optional<std::chrono::steady_clock::time_point> &idleTasksRetryTime);
+
+    /**
+     * Includes tasks that are being pushed and may not be poppable yet.
+     */
+    size_t getPushedTasksCount() const {
+        return m_pushedTasksCount.load(std::memory_order_acquire);
+    }
+
+    std::vector<TaskLaneStats> getStats() const;
+
+  private:
+    struct Lane {
+        TaskQueue queue;
+        std::atomic_size_t depth{0};
+        Log2Histogram queueDepthHistogram;
+        Log2Histogram waitTimeInUsHistogram;
+    };
+
+    bool tryPopFromLane(Lane &lane, UniqueTask &task);
+
+    FrameDeadlineProvider m_frameDeadlineProvider;
+    std::array<Lane, TASK_PRIORITIES_COUNT> m_lanes;
+    std::atomic_size_t m_pushedTasksCount{0};
+};
+
+} // namespace rnoh
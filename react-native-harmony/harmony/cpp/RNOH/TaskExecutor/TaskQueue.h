@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "RNOH/MPSCRingBuffer.h"
+#include "Parker.h"
+#include "UniqueTask.h"
+
+namespace rnoh {
+
+/**
+ * Multi-producer single-consumer task queue. Pushing and popping are lock-free until the ring buffer fills up; then
+ * tasks go to a mutex-guarded overflow queue, so pushing never fails. The consumer moves overflowing tasks back into
+ * the ring buffer once it drains, so the queue returns to the lock-free path as soon as it can.
+ */
+class TaskQueue {
+  public:
+    // NOTE: reading the clock costs as much as the rest of `push`, so only every n-th push on a thread is timestamped
+    static constexpr uint32_t PUSH_TIME_SAMPLING_INTERVAL = 16;
+
+    TaskQueue(size_t capacity = 1024) : m_ringBuffer(capacity) {}
+
+    void push(UniqueTask &&task) {
+        thread_local uint32_t pushesCount = 0;
+        QueuedTask queuedTask{std::move(task), {}};
+        if (pushesCount++ % PUSH_TIME_SAMPLING_INTERVAL == 0) {
+            queuedTask.pushedAt = std::chrono::steady_clock::now();
+        }
+        if (m_isOverflowing.load(std::memory_order_acquire) || !m_ringBuffer.tryPush(std::move(queuedTask))) {
+            std::lock_guard<std::mutex> lock(m_overflowMutex);
+            m_isOverflowing.store(true, std::memory_order_release);
+            m_overflow.push_back(std::move(queuedTask));
+        }
+    }
+
+    /**
+     * Must be called only from the consumer thread. `pushedAt` is std::nullopt for tasks whose push time wasn't
+     * sampled.
+     */
+    bool tryPop(UniqueTask &task, std::optional<std::chrono::steady_clock::time_point> &pushedAt) {
+        QueuedTask queuedTask;
+        if (!tryPop(queuedTask)) {
+            return false;
+        }
+        task = std::move(queuedTask.task);
+        pushedAt = queuedTask.pushedAt;
+        return true;
+    }
+
+    bool tryPop(UniqueTask &task) {
+        std::optional<std::chrono::steady_clock::time_point> pushedAt;
+        return tryPop(task, pushedAt);
+    }
+
+  private:
+    struct QueuedTask {
+        UniqueTask task;
+        std::optional<std::chrono::steady_clock::time_point> pushedAt;
+    };
+
+    bool tryPop(QueuedTask &queuedTask) {
+        if (m_ringBuffer.tryPop(queuedTask)) {
+            return true;
+        }
+        if (!m_isOverflowing.load(std::memory_order_acquire)) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(m_overflowMutex);
+        // NOTE: tasks in the ring buffer were pushed before the overflowing ones
+        if (m_ringBuffer.tryPop(queuedTask)) {
+            return true;
+        }
+        // NOTE: the ring buffer is empty, and producers can't push to it while the overflow flag is set, so the
+        // order of tasks is kept
+        while (!m_overflow.empty() && m_ringBuffer.tryPush(std::move(m_overflow.front()))) {
+            m_overflow.pop_front();
+        }
+        if (m_overflow.empty()) {
+            m_isOverflowing.store(false, std::memory_order_release);
+        }
+        return m_ringBuffer.tryPop(queuedTask);
+    }
+
+    MPSCRingBuffer<QueuedTask> m_ringBuffer;
+    std::atomic_bool m_isOverflowing = false;
+    std::mutex m_overflowMutex;
+    std::deque<QueuedTask> m_overflow;
+};
+
+/**
+ * Releases the thread waiting in `wait` when destroyed. Captured by sync tasks, so the waiter is also released when the
+ * task is dropped without being executed (e.g. when the runner is destroyed).
+ */
+class SyncTaskCompletion {
+  public:
+    class Guard {
+      public:
+        Guard(std::shared_ptr<SyncTaskCompletion> completion) : m_completion(std::move(completion)) {}
+        Guard(Guard &&other) noexcept = default;
+        Guard(const Guard &) = delete;
+
+        ~Guard() {
+            if (m_completion != nullptr) {
+                m_completion->m_isDone.store(1, std::memory_order_release);
+                futexWakeAll(m_completion->m_isDone);
+            }
+        }
+
+      private:
+        std::shared_ptr<SyncTaskCompletion> m_completion;
+    };
+
+    void wait() {
+        while (m_isDone.load(std::memory_order_acquire) == 0) {
+            futexWait(m_isDone, 0);
+        }
+    }
+
+  private:
+    std::atomic<int32_t> m_isDone{0};
+};
+
+} // namespace rnoh
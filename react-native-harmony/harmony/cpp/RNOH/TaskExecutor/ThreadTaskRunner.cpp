@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <atomic>
 #include <exception>
 #include <glog/logging.h>
@@ -5,7 +6,8 @@
 
 namespace rnoh {
 
-ThreadTaskRunner::ThreadTaskRunner(std::string name) : name(name) {
+ThreadTaskRunner::ThreadTaskRunner(std::string name, FrameDeadlineProvider frameDeadlineProvider)
+    : name(name), taskLanes(std::move(frameDeadlineProvider)) {
     thread = std::thread([this] { runLoop(); });
     auto handle = thread.native_handle();
     pthread_setname_np(handle, name.c_str());
@@ -14,85 +16,104 @@ ThreadTaskRunner::ThreadTaskRunner(std::string name) : name(name) {
 ThreadTaskRunner::~ThreadTaskRunner() {
     LOG(INFO) << "Shutting down thread runner " << name;
     running = false;
-    cv.notify_all();
+    parker.unpark();
     thread.join();
 }
 
 void ThreadTaskRunner::runAsyncTask(Task &&task) {
-    {
-        std::unique_lock<std::mutex> lock(mutex);
-        asyncTaskQueue.emplace(std::move(task));
-    }
-    // NOTE: this should be fine:
-    // the only threads waiting on the condition variable are the
-    // runner thread and the thread that called runSyncTask,
-    // and if some thread is waiting in runSyncTask,
-    // the runner thread should be running and executing its task
-    if (std::this_thread::get_id() != thread.get_id()) {
-        cv.notify_one();
-    }
+    runAsyncTask(std::move(task), TaskPriority::NORMAL);
+}
+
+void ThreadTaskRunner::runAsyncTask(Task &&task, TaskPriority priority) {
+    taskLanes.push(std::move(task), priority);
+    wakeUp();
 }
 
 void ThreadTaskRunner::runSyncTask(Task &&task) {
+    runSyncTask(std::move(task), TaskPriority::NORMAL);
+}
+
+void ThreadTaskRunner::runSyncTask(Task &&task, TaskPriority priority) {
     if (isOnCurrentThread()) {
         task();
         return;
     }
-    std::unique_lock<std::mutex> lock(mutex);
-    std::atomic_bool done{false};
-    syncTaskQueue.emplace([task = std::move(task), &done] {
-        task();
-        done = true;
-    });
-    cv.notify_all();
-    cv.wait(lock, [this, &done] { return !running.load() || done.load(); });
+    auto completion = std::make_shared<SyncTaskCompletion>();
+    taskLanes.push([task = std::move(task), guard = SyncTaskCompletion::Guard(completion)] { task(); }, priority);
+    wakeUp();
+    completion->wait();
+}
+
+rnoh::TimerId ThreadTaskRunner::runDelayedTask(Task &&task, std::chrono::steady_clock::time_point deadline) {
+    if (!isOnCurrentThread()) {
+        throw std::runtime_error("Delayed tasks must be scheduled on the runner's thread");
+    }
+    return timerWheel.add(deadline, std::move(task));
+}
+
+bool ThreadTaskRunner::cancelDelayedTask(rnoh::TimerId timerId) {
+    if (!isOnCurrentThread()) {
+        throw std::runtime_error("Delayed tasks must be cancelled on the runner's thread");
+    }
+    return timerWheel.cancel(timerId);
 }
 
 bool ThreadTaskRunner::isOnCurrentThread() const {
     return std::this_thread::get_id() == thread.get_id();
 }
 
+std::vector<TaskLaneStats> ThreadTaskRunner::getTaskLaneStats() const {
+    return taskLanes.getStats();
+}
+
+void ThreadTaskRunner::wakeUp() {
+    // NOTE: the runner thread checks the queues before parking, so it doesn't need to wake itself up
+    if (!isOnCurrentThread()) {
+        parker.unpark();
+    }
+}
+
 void ThreadTaskRunner::runLoop() {
     while (running) {
-        std::unique_lock<std::mutex> lock(mutex);
-        cv.wait(lock, [this] { return hasPendingTasks() || !running; });
-        if (!running) {
-            return;
-        }
-        if (!syncTaskQueue.empty()) {
-            auto task = std::move(syncTaskQueue.front());
-            syncTaskQueue.pop();
-            lock.unlock();
-            try {
-                task();
-            } catch (std::exception const &e) {
-                LOG(ERROR) << "Exception thrown in sync task";
-                LOG(ERROR) << e.what();
+        if (!timerWheel.isEmpty()) {
+            timerWheel.advance(std::chrono::steady_clock::now(), expiredDelayedTasks);
+            for (auto &delayedTask : expiredDelayedTasks) {
+                runTask(delayedTask);
             }
-            // notify the threads that called runSyncTask.
-            // it's not enough to notify one thread,
-            // because there could be multiple threads calling runSyncTask
-            // at the same time
-            cv.notify_all();
+            expiredDelayedTasks.clear();
+        }
+        Task task;
+        std::optional<std::chrono::steady_clock::time_point> idleTasksRetryTime;
+        if (taskLanes.tryPop(task, idleTasksRetryTime)) {
+            runTask(task);
             continue;
         }
-        if (!asyncTaskQueue.empty()) {
-            auto task = std::move(asyncTaskQueue.front());
-            asyncTaskQueue.pop();
-            lock.unlock();
-            try {
-                task();
-            } catch (std::exception const &e) {
-                LOG(ERROR) << "Exception thrown in task";
-                LOG(ERROR) << e.what();
-                try {
-                    std::rethrow_if_nested(e);
-                } catch (const std::exception &nested) {
-                    LOG(ERROR) << nested.what();
-                }
-            }
+        auto wakeUpTime = timerWheel.getNextWakeUpTime();
+        if (idleTasksRetryTime.has_value()) {
+            wakeUpTime = std::min(wakeUpTime.value_or(idleTasksRetryTime.value()), idleTasksRetryTime.value());
+        }
+        if (wakeUpTime.has_value()) {
+            parker.parkUntil(wakeUpTime.value());
+        } else {
+            parker.park();
+        }
+    }
+}
+
+void ThreadTaskRunner::runTask(Task &task) {
+    try {
+        task();
+    } catch (std::exception const &e) {
+        LOG(ERROR) << "Exception thrown in task";
+        LOG(ERROR) << e.what();
+        try {
+            std::rethrow_if_nested(e);
+        } catch (const std::exception &nested) {
+            LOG(ERROR) << nested.what();
         }
     }
+    // NOTE: destroying a sync task releases the thread that called runSyncTask
+    task = nullptr;
 }
 
 } // namespace rnoh
@@ -1,43 +1,48 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
 #include <functional>
-#include <mutex>
-#include <queue>
 #include <thread>
 
 #include "AbstractTaskRunner.h"
+#include "Parker.h"
+#include "TaskLanes.h"
+#include "TimerWheel.h"
 
 namespace rnoh {
 
 class ThreadTaskRunner : public AbstractTaskRunner {
   public:
-    ThreadTaskRunner(std::string name);
+    ThreadTaskRunner(std::string name, FrameDeadlineProvider frameDeadlineProvider = nullptr);
     ~ThreadTaskRunner() override;
 
     ThreadTaskRunner(const ThreadTaskRunner &) = delete;
     ThreadTaskRunner &operator=(const ThreadTaskRunner &) = delete;
 
     void runAsyncTask(Task &&task) override;
+    void runAsyncTask(Task &&task, TaskPriority priority) override;
     void runSyncTask(Task &&task) override;
+    void runSyncTask(Task &&task, TaskPriority priority) override;
+    rnoh::TimerId runDelayedTask(Task &&task, std::chrono::steady_clock::time_point deadline) override;
+    bool cancelDelayedTask(rnoh::TimerId timerId) override;
 
     bool isOnCurrentThread() const override;
 
+    std::vector<TaskLaneStats> getTaskLaneStats() const override;
+
   private:
     void runLoop();
-
-    bool hasPendingTasks() const {
-        return !asyncTaskQueue.empty() || !syncTaskQueue.empty();
-    }
+    void runTask(Task &task);
+    void wakeUp();
 
     std::string name;
     std::atomic_bool running{true};
+    TaskLanes taskLanes;
+    // NOTE: accessed only on the runner thread
+    TimerWheel timerWheel;
+    std::vector<Task> expiredDelayedTasks;
+    Parker parker;
     std::thread thread;
-    std::queue<std::function<void()>> asyncTaskQueue;
-    std::queue<std::function<void()>> syncTaskQueue;
-    std::mutex mutex;
-    std::condition_variable cv;
 };
 
-} // namespace rnoh
\ No newline at end of file
+} // namespace rnoh
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include "TimerWheel.h"
+
+namespace rnoh {
+
+static uint64_t rotateRight(uint64_t value, size_t shift) {
+    shift &= 63;
+    return shift == 0 ? value : (value >> shift) | (value << (64 - shift));
+}
+
+TimerId TimerWheel::add(Clock::time_point deadline, UniqueTask &&task) {
+    auto timerId = m_nextTimerId++;
+    auto &timer = m_timerById[timerId];
+    // NOTE: rounded up, so timers never fire before their deadline
+    auto deadlineTick = toTick(deadline);
+    if (toTimePoint(deadlineTick) < deadline) {
+        deadlineTick++;
+    }
+    timer.deadlineTick = deadlineTick;
+    timer.task = std::move(task);
+    place(timerId, timer);
+    return timerId;
+}
+
+bool TimerWheel::cancel(TimerId timerId) {
+    auto it = m_timerById.find(timerId);
+    if (it == m_timerById.end()) {
+        return false;
+    }
+    unplace(it->second);
+    m_timerById.erase(it);
+    return true;
+}
+
+void TimerWheel::advance(Clock::time_point now, std::vector<UniqueTask> &expiredTasks) {
+    expireSlot(m_expiredTimerIds, expiredTasks);
+    auto nowTick = toTick(now);
+    while (m_currentTick < nowTick) {
+        // NOTE: ticks with nothing to cascade or expire are skipped
+        auto nextEventTick = std::min(getNextEventTick().value_or(nowTick), nowTick);
+        m_currentTick = std::max(nextEventTick, m_currentTick + 1);
+        // NOTE: higher levels first, a cascaded timer can land in a lower level slot that is due at this tick
+        for (size_t level = LEVELS_COUNT - 1; level > 0; level--) {
+            if ((m_currentTick & ((uint64_t(1) << (LEVEL_BITS * level)) - 1)) == 0) {
+                cascade(level);
+            }
+        }
+        auto &level0 = m_levels[0];
+        auto slotIdx = m_currentTick & (SLOTS_COUNT - 1);
+        level0.occupiedSlots &= ~(uint64_t(1) << slotIdx);
+        expireSlot(level0.slots[slotIdx], expiredTasks);
+        // NOTE: timers cascaded from the top level can be due right at this tick
+        expireSlot(m_expiredTimerIds, expiredTasks);
+    }
+}
+
+std::optional<TimerWheel::Clock::time_point> TimerWheel::getNextWakeUpTime() const {
+    if (!m_expiredTimerIds.empty()) {
+        return toTimePoint(m_currentTick);
+    }
+    auto nextEventTick = getNextEventTick();
+    if (!nextEventTick.has_value()) {
+        return std::nullopt;
+    }
+    return toTimePoint(nextEventTick.value());
+}
+
+std::optional<uint64_t> TimerWheel::getNextEventTick() const {
+    std::optional<uint64_t> result;
+    for (size_t level = 0; level < LEVELS_COUNT; level++) {
+        auto occupiedSlots = m_levels[level].occupiedSlots;
+        if (occupiedSlots == 0) {
+            continue;
+        }
+        auto shift = LEVEL_BITS * level;
+        auto nextSlotsIdx = (m_currentTick >> shift) + 1;
+        // NOTE: bit k of `rotatedSlots` is the slot visited k slots after the next one
+        auto rotatedSlots = rotateRight(occupiedSlots, nextSlotsIdx & (SLOTS_COUNT - 1));
+        auto tick = (nextSlotsIdx + __builtin_ctzll(rotatedSlots)) << shift;
+        result = std::min(result.value_or(tick), tick);
+    }
+    return result;
+}
+
+uint64_t TimerWheel::toTick(Clock::time_point timePoint) const {
+    if (timePoint <= m_startTime) {
+        return 0;
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(timePoint - m_startTime).count();
+}
+
+TimerWheel::Clock::time_point TimerWheel::toTimePoint(uint64_t tick) const {
+    return m_startTime + std::chrono::milliseconds(tick);
+}
+
+void TimerWheel::place(TimerId timerId, Timer &timer) {
+    std::vector<TimerId> *slot;
+    if (timer.deadlineTick <= m_currentTick) {
+        timer.level = EXPIRED_LEVEL;
+        slot = &m_expiredTimerIds;
+    } else {
+        // NOTE: timers further away than the wheel's range are parked at the top level and re-placed when it cascades
+        auto ticksAhead = std::min(timer.deadlineTick - m_currentTick, MAX_TICKS_AHEAD);
+        auto placementTick = m_currentTick + ticksAhead;
+        size_t level = 0;
+        while (level < LEVELS_COUNT - 1 && ticksAhead >= (uint64_t(1) << (LEVEL_BITS * (level + 1)))) {
+            level++;
+        }
+        timer.level = level;
+        timer.slotIdx = (placementTick >> (LEVEL_BITS * level)) & (SLOTS_COUNT - 1);
+        m_levels[level].occupiedSlots |= uint64_t(1) << timer.slotIdx;
+        slot = &m_levels[level].slots[timer.slotIdx];
+    }
+    timer.idxInSlot = slot->size();
+    slot->push_back(timerId);
+}
+
+void TimerWheel::unplace(Timer &timer) {
+    auto &slot = timer.level == EXPIRED_LEVEL ? m_expiredTimerIds : m_levels[timer.level].slots[timer.slotIdx];
+    auto lastTimerId = slot.back();
+    slot[timer.idxInSlot] = lastTimerId;
+    m_timerById.at(lastTimerId).idxInSlot = timer.idxInSlot;
+    slot.pop_back();
+    if (slot.empty() && timer.level != EXPIRED_LEVEL) {
+        m_levels[timer.level].occupiedSlots &= ~(uint64_t(1) << timer.slotIdx);
+    }
+}
+
+void TimerWheel::cascade(size_t level) {
+    auto slotIdx = (m_currentTick >> (LEVEL_BITS * level)) & (SLOTS_COUNT - 1);
+    auto timerIds = std::move(m_levels[level].slots[slotIdx]);
+    m_levels[level].slots[slotIdx].clear();
+    m_levels[level].occupiedSlots &= ~(uint64_t(1) << slotIdx);
+    for (auto timerId : timerIds) {
+        place(timerId, m_timerById.at(timerId));
+    }
+}
+
+void TimerWheel::expireSlot(std::vector<TimerId> &slot, std::vector<UniqueTask> &expiredTasks) {
+    auto timerIds = std::move(slot);
+    slot.clear();
+    for (auto timerId : timerIds) {
+        auto it = m_timerById.find(timerId);
+        expiredTasks.push_back(std::move(it->second.task));
+        m_timerById.erase(it);
+    }
+}
+
+} // namespace rnoh
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "UniqueTask.h"
+
+namespace rnoh {
+
+using TimerId = uint64_t;
+
+/**
+ * Hierarchical timer wheel with a 1 ms resolution: LEVELS_COUNT levels of SLOTS_COUNT slots, each level covering
+ * SLOTS_COUNT times the range of the previous one. Adding and cancelling a timer is O(1); timers are moved to lower
+ * levels as their deadline approaches. Not thread-safe, it's meant to be owned by the thread that runs the timers.
+ */
+class TimerWheel {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    TimerWheel(Clock::time_point startTime = Clock::now()) : m_startTime(startTime) {}
+
+    TimerId add(Clock::time_point deadline, UniqueTask &&task);
+
+    /**
+     * Returns false if the timer already fired or was cancelled.
+     */
+    bool cancel(TimerId timerId);
+
+    /**
+     * Moves tasks of timers that are due at `now` to `expiredTasks`, ordered by their deadlines.
+     */
+    void advance(Clock::time_point now, std::vector<UniqueTask> &expiredTasks);
+
+    /**
+     * Returns the time `advance` should be called next, or nullopt if there are no timers.
+     * The time may be earlier than the nearest deadline, when timers need to be moved to a lower level.
+     */
+    std::optional<Clock::time_point> getNextWakeUpTime() const;
+
+    bool isEmpty() const {
+        return m_timerById.empty();
+    }
+
+    size_t size() const {
+        return m_timerById.size();
+    }
+
+  private:
+    static constexpr size_t LEVEL_BITS = 6;
+    static constexpr size_t SLOTS_COUNT = 1 << LEVEL_BITS;
+    static constexpr size_t LEVELS_COUNT = 4;
+    static constexpr uint64_t MAX_TICKS_AHEAD = (uint64_t(1) << (LEVEL_BITS * LEVELS_COUNT)) - 1;
+    static constexpr size_t EXPIRED_LEVEL = LEVELS_COUNT;
+
+    struct Timer {
+        uint64_t deadlineTick;
+        UniqueTask task;
+        size_t level;
+        size_t slotIdx;
+        size_t idxInSlot;
+    };
+
+    struct Level {
+        std::array<std::vector<TimerId>, SLOTS_COUNT> slots;
+        // NOTE: bit i is set if slot i isn't empty
+        uint64_t occupiedSlots = 0;
+    };
+
+    std::optional<uint64_t> getNextEventTick() const;
+    uint64_t toTick(Clock::time_point timePoint) const;
+    Clock::time_point toTimePoint(uint64_t tick) const;
+    void place(TimerId timerId, Timer &timer);
+    void unplace(Timer &timer);
+    void cascade(size_t level);
+    void expireSlot(std::vector<TimerId> &slot, std::vector<UniqueTask> &expiredTasks);
+
+    Clock::time_point m_startTime;
+    uint64_t m_currentTick = 0;
+    TimerId m_nextTimerId = 1;
+    std::unordered_map<TimerId, Timer> m_timerById;
+    std::array<Level, LEVELS_COUNT> m_levels;
+    // NOTE: timers added with a deadline that has already passed, fired by the next `advance`
+    std::vector<TimerId> m_expiredTimerIds;
+};
+
+} // namespace rnoh
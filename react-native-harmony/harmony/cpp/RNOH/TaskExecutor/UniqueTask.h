@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rnoh {
+
+/**
+ * Move-only `void()` callable. Callables up to INLINE_CAPACITY bytes (most lambdas posted to task runners) are stored
+ * inline, so creating and moving a task doesn't allocate. Unlike std::function, it accepts move-only callables.
+ */
+class UniqueTask {
+  public:
+    static constexpr size_t INLINE_CAPACITY = 64;
+
+    UniqueTask() noexcept = default;
+    UniqueTask(std::nullptr_t) noexcept {}
+
+    template <
+        typename F,
+        typename Fn = std::decay_t<F>,
+        typename = std::enable_if_t<!std::is_same_v<Fn, UniqueTask> && std::is_invocable_r_v<void, Fn &>>>
+    UniqueTask(F &&fn) {
+        if constexpr (std::is_same_v<Fn, std::function<void()>>) {
+            if (!fn) {
+                return;
+            }
+        }
+        if constexpr (isStoredInline<Fn>()) {
+            new (&m_storage) Fn(std::forward<F>(fn));
+            m_vtable = &inlineVTable<Fn>;
+        } else {
+            *reinterpret_cast<Fn **>(&m_storage) = new Fn(std::forward<F>(fn));
+            m_vtable = &heapVTable<Fn>;
+        }
+    }
+
+    UniqueTask(UniqueTask &&other) noexcept {
+        moveFrom(other);
+    }
+
+    UniqueTask &operator=(UniqueTask &&other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    UniqueTask(const UniqueTask &) = delete;
+    UniqueTask &operator=(const UniqueTask &) = delete;
+
+    ~UniqueTask() {
+        reset();
+    }
+
+    explicit operator bool() const noexcept {
+        return m_vtable != nullptr;
+    }
+
+    void operator()() const {
+        if (m_vtable == nullptr) {
+            throw std::bad_function_call();
+        }
+        m_vtable->invoke(const_cast<Storage *>(&m_storage));
+    }
+
+  private:
+    using Storage = std::aligned_storage_t<INLINE_CAPACITY, alignof(std::max_align_t)>;
+
+    struct VTable {
+        void (*invoke)(Storage *storage);
+        void (*move)(Storage *from, Storage *to) noexcept;
+        void (*destroy)(Storage *storage) noexcept;
+    };
+
+    template <typename Fn>
+    static constexpr bool isStoredInline() {
+        return sizeof(Fn) <= INLINE_CAPACITY && alignof(Fn) <= alignof(Storage) && std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <typename Fn>
+    static constexpr VTable inlineVTable = {
+        [](Storage *storage) { (*std::launder(reinterpret_cast<Fn *>(storage)))(); },
+        [](Storage *from, Storage *to) noexcept {
+            auto fn = std::launder(reinterpret_cast<Fn *>(from));
+            new (to) Fn(std::move(*fn));
+            fn->~Fn();
+        },
+        [](Storage *storage) noexcept { std::launder(reinterpret_cast<Fn *>(storage))->~Fn(); },
+    };
+
+    template <typename Fn>
+    static constexpr VTable heapVTable = {
+        [](Storage *storage) { (**reinterpret_cast<Fn **>(storage))(); },
+        [](Storage *from, Storage *to) noexcept { *reinterpret_cast<Fn **>(to) = *reinterpret_cast<Fn **>(from); },
+        [](Storage *storage) noexcept { delete *reinterpret_cast<Fn **>(storage); },
+    };
+
+    void moveFrom(UniqueTask &other) noexcept {
+        if (other.m_vtable != nullptr) {
+            other.m_vtable->move(&other.m_storage, &m_storage);
+            m_vtable = other.m_vtable;
+            other.m_vtable = nullptr;
+        }
+    }
+
+    void reset() noexcept {
+        if (m_vtable != nullptr) {
+            m_vtable->destroy(&m_storage);
+            m_vtable = nullptr;
+        }
+    }
+
+    Storage m_storage;
+    VTable const *m_vtable = nullptr;
+};
+
+} // namespace rnoh
@@ -1,26 +1,36 @@
 #pragma once
 #include <react/renderer/graphics/Size.h>
 #include <react/renderer/textlayoutmanager/TextLayoutManager.h>
-#include <string>
-#include "napi/native_api.h"
-#include "RNOH/TaskExecutor/TaskExecutor.h"
+#include "RNOH/OHOSTextMeasurer.h"
 
 namespace rnoh {
 class TextMeasurer : public facebook::react::TextLayoutManagerDelegate {
 
   public:
-    TextMeasurer(napi_env env, napi_ref measureTextFnRef, std::shared_ptr<TaskExecutor> taskExecutor)
-        : m_env(env),
-          m_measureTextFnRef(measureTextFnRef),
-          m_taskExecutor(taskExecutor) {}
+    TextMeasurer() : m_ohosTextMeasurer(std::make_shared<OHOSTextMeasurer>()) {}
 
     facebook::react::TextMeasurement measure(facebook::react::AttributedString attributedString,
                                    facebook::react::ParagraphAttributes paragraphAttributes,
-                                   facebook::react::LayoutConstraints layoutConstraints);
+                                   facebook::react::LayoutConstraints layoutConstraints) override;
+
+    facebook::react::TextMeasurement measure(facebook::react::AttributedString attributedString,
+                                   facebook::react::ParagraphAttributes paragraphAttributes,
+                                   facebook::react::LayoutConstraints layoutConstraints,
+                                   std::shared_ptr<void> hostTextStorage) override;
+
+    facebook::react::LinesMeasurements measureLines(facebook::react::AttributedString attributedString,
+                                   facebook::react::ParagraphAttributes paragraphAttributes,
+                                   facebook::react::Size size) override;
+
+    /**
+     * Returns an empty OHOSTextMeasurer::TextStorage. The typography is laid out into it by the first measurement that
+     * misses the TextMeasurementCache, and reused by the subsequent ones.
+     */
+    std::shared_ptr<void> getHostTextStorage(facebook::react::AttributedString attributedString,
+                                   facebook::react::ParagraphAttributes paragraphAttributes,
+                                   facebook::react::LayoutConstraints layoutConstraints) override;
 
   private:
-    napi_env m_env;
-    napi_ref m_measureTextFnRef;
-    std::shared_ptr<TaskExecutor> m_taskExecutor;
+    OHOSTextMeasurer::Shared m_ohosTextMeasurer;
 };
 } // namespace rnoh
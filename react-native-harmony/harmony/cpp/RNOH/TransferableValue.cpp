@@ -0,0 +1,421 @@
+#include "RNOH/TransferableValue.h"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <jsi/jsi.h>
+
+using namespace facebook;
+using namespace rnoh;
+
+namespace {
+
+using Buffer = std::vector<uint8_t>;
+
+static constexpr size_t MAX_SHORT_STRING_LENGTH = std::numeric_limits<uint8_t>::max();
+
+void maybeThrowFromStatus(napi_status status, const char *message) {
+    if (status != napi_ok) {
+        throw std::runtime_error(message);
+    }
+}
+
+class Writer {
+  public:
+    Writer(Buffer &buffer) : m_buffer(buffer) {}
+
+    template <typename T>
+    void write(T value) {
+        auto offset = m_buffer.size();
+        m_buffer.resize(offset + sizeof(T));
+        std::memcpy(m_buffer.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    void writeAt(size_t offset, T value) {
+        std::memcpy(m_buffer.data() + offset, &value, sizeof(T));
+    }
+
+    void writeString(std::string_view str) {
+        std::memcpy(allocateString(str.size()), str.data(), str.size());
+    }
+
+    void writeKey(std::string_view key) {
+        std::memcpy(allocateKey(key.size()), key.data(), key.size());
+    }
+
+    /**
+     * Writes the header of a `length` bytes long string and returns where its bytes go, followed by NUL.
+     */
+    char *allocateString(size_t length) {
+        if (length <= MAX_SHORT_STRING_LENGTH) {
+            write<uint8_t>(TransferableValue::SHORT_STRING);
+            write<uint8_t>(length);
+        } else {
+            write<uint8_t>(TransferableValue::STRING);
+            write<uint32_t>(checkLength(length));
+        }
+        return allocateBytes(length);
+    }
+
+    char *allocateKey(size_t length) {
+        write<uint32_t>(checkLength(length));
+        return allocateBytes(length);
+    }
+
+    /**
+     * Drops the tags of `count` NUMBER items written after `headerOffset`, turning the ARRAY into a NUMBER_ARRAY.
+     */
+    void compactNumberArray(size_t headerOffset, uint32_t count) {
+        auto items = m_buffer.data() + headerOffset + sizeof(uint8_t) + sizeof(uint32_t);
+        for (uint32_t i = 0; i < count; i++) {
+            std::memmove(items + i * sizeof(double), items + i * (sizeof(uint8_t) + sizeof(double)) + sizeof(uint8_t), sizeof(double));
+        }
+        m_buffer.resize(items - m_buffer.data() + count * sizeof(double));
+        m_buffer[headerOffset] = TransferableValue::NUMBER_ARRAY;
+    }
+
+    size_t size() const {
+        return m_buffer.size();
+    }
+
+  private:
+    static uint32_t checkLength(size_t length) {
+        if (length > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("String is too long to be transferred");
+        }
+        return static_cast<uint32_t>(length);
+    }
+
+    char *allocateBytes(size_t length) {
+        auto offset = m_buffer.size();
+        m_buffer.resize(offset + length + 1);
+        m_buffer[offset + length] = '\0';
+        return reinterpret_cast<char *>(m_buffer.data() + offset);
+    }
+
+    Buffer &m_buffer;
+};
+
+class Reader {
+  public:
+    Reader(Buffer const &buffer) : m_data(buffer.data()) {}
+
+    template <typename T>
+    T read() {
+        T value;
+        std::memcpy(&value, m_data + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return value;
+    }
+
+    std::string_view readString(uint8_t type) {
+        size_t length = type == TransferableValue::SHORT_STRING ? read<uint8_t>() : read<uint32_t>();
+        return readBytes(length);
+    }
+
+    /**
+     * The returned view is NUL-terminated.
+     */
+    std::string_view readKey() {
+        return readBytes(read<uint32_t>());
+    }
+
+  private:
+    std::string_view readBytes(size_t length) {
+        std::string_view result(reinterpret_cast<char const *>(m_data + m_offset), length);
+        m_offset += length + 1;
+        return result;
+    }
+
+    uint8_t const *m_data;
+    size_t m_offset = 0;
+};
+
+uint8_t writeJsiValue(jsi::Runtime &rt, jsi::Value const &value, Writer &writer);
+
+void writeJsiArray(jsi::Runtime &rt, jsi::Array const &array, Writer &writer) {
+    auto count = static_cast<uint32_t>(array.size(rt));
+    auto headerOffset = writer.size();
+    writer.write<uint8_t>(TransferableValue::ARRAY);
+    writer.write<uint32_t>(count);
+    bool hasOnlyNumbers = true;
+    for (uint32_t i = 0; i < count; i++) {
+        hasOnlyNumbers &= writeJsiValue(rt, array.getValueAtIndex(rt, i), writer) == TransferableValue::NUMBER;
+    }
+    if (hasOnlyNumbers && count > 0) {
+        writer.compactNumberArray(headerOffset, count);
+    }
+}
+
+void writeJsiObject(jsi::Runtime &rt, jsi::Object const &object, Writer &writer) {
+    auto names = object.getPropertyNames(rt);
+    auto namesCount = names.size(rt);
+    writer.write<uint8_t>(TransferableValue::OBJECT);
+    auto countOffset = writer.size();
+    writer.write<uint32_t>(0);
+    uint32_t count = 0;
+    for (size_t i = 0; i < namesCount; i++) {
+        auto name = names.getValueAtIndex(rt, i).getString(rt);
+        auto property = object.getProperty(rt, name);
+        if (property.isUndefined()) {
+            continue;
+        }
+        writer.writeKey(name.utf8(rt));
+        // NOTE: JSON.stringify replaces functions in objects with null as well
+        if (property.isObject() && property.getObject(rt).isFunction(rt)) {
+            writer.write<uint8_t>(TransferableValue::NULL_VALUE);
+        } else {
+            writeJsiValue(rt, property, writer);
+        }
+        count++;
+    }
+    writer.writeAt<uint32_t>(countOffset, count);
+}
+
+uint8_t writeJsiValue(jsi::Runtime &rt, jsi::Value const &value, Writer &writer) {
+    if (value.isNumber()) {
+        writer.write<uint8_t>(TransferableValue::NUMBER);
+        writer.write<double>(value.getNumber());
+        return TransferableValue::NUMBER;
+    }
+    if (value.isUndefined() || value.isNull()) {
+        writer.write<uint8_t>(TransferableValue::NULL_VALUE);
+        return TransferableValue::NULL_VALUE;
+    }
+    if (value.isBool()) {
+        auto type = value.getBool() ? TransferableValue::TRUE_VALUE : TransferableValue::FALSE_VALUE;
+        writer.write<uint8_t>(type);
+        return type;
+    }
+    if (value.isString()) {
+        writer.writeString(value.getString(rt).utf8(rt));
+        return TransferableValue::STRING;
+    }
+    if (value.isObject()) {
+        auto object = value.getObject(rt);
+        if (object.isArray(rt)) {
+            writeJsiArray(rt, object.getArray(rt), writer);
+            return TransferableValue::ARRAY;
+        }
+        if (object.isFunction(rt)) {
+            throw jsi::JSError(rt, "JS Functions can only be passed to TurboModules as arguments");
+        }
+        writeJsiObject(rt, object, writer);
+        return TransferableValue::OBJECT;
+    }
+    if (value.isBigInt()) {
+        throw jsi::JSError(rt, "JS BigInts are not transferable");
+    }
+    if (value.isSymbol()) {
+        throw jsi::JSError(rt, "JS Symbols are not transferable");
+    }
+    throw jsi::JSError(rt, "Value is not transferable");
+}
+
+uint8_t writeNapiValue(napi_env env, napi_value value, Writer &writer) {
+    napi_valuetype valueType;
+    maybeThrowFromStatus(napi_typeof(env, value, &valueType), "Failed to get value type");
+    switch (valueType) {
+    case napi_number: {
+        double number;
+        maybeThrowFromStatus(napi_get_value_double(env, value, &number), "Failed to retrieve double value");
+        writer.write<uint8_t>(TransferableValue::NUMBER);
+        writer.write<double>(number);
+        return TransferableValue::NUMBER;
+    }
+    case napi_boolean: {
+        bool boolean;
+        maybeThrowFromStatus(napi_get_value_bool(env, value, &boolean), "Failed to retrieve boolean value");
+        auto type = boolean ? TransferableValue::TRUE_VALUE : TransferableValue::FALSE_VALUE;
+        writer.write<uint8_t>(type);
+        return type;
+    }
+    case napi_string: {
+        size_t length;
+        maybeThrowFromStatus(napi_get_value_string_utf8(env, value, nullptr, 0, &length), "Failed to get the length of the string");
+        // NOTE: copied straight into the buffer, NUL included
+        auto data = writer.allocateString(length);
+        maybeThrowFromStatus(napi_get_value_string_utf8(env, value, data, length + 1, &length), "Failed to get the string data");
+        return TransferableValue::STRING;
+    }
+    case napi_object: {
+        bool isArray;
+        maybeThrowFromStatus(napi_is_array(env, value, &isArray), "Failed to check if value is an array");
+        if (isArray) {
+            uint32_t count;
+            maybeThrowFromStatus(napi_get_array_length(env, value, &count), "Failed to read array length");
+            auto headerOffset = writer.size();
+            writer.write<uint8_t>(TransferableValue::ARRAY);
+            writer.write<uint32_t>(count);
+            bool hasOnlyNumbers = true;
+            for (uint32_t i = 0; i < count; i++) {
+                napi_value item;
+                maybeThrowFromStatus(napi_get_element(env, value, i, &item), "Failed to retrieve value at index");
+                hasOnlyNumbers &= writeNapiValue(env, item, writer) == TransferableValue::NUMBER;
+            }
+            if (hasOnlyNumbers && count > 0) {
+                writer.compactNumberArray(headerOffset, count);
+            }
+            return TransferableValue::ARRAY;
+        }
+        napi_value names;
+        maybeThrowFromStatus(napi_get_property_names(env, value, &names), "Failed to retrieve property names");
+        uint32_t count;
+        maybeThrowFromStatus(napi_get_array_length(env, names, &count), "Failed to read array length");
+        writer.write<uint8_t>(TransferableValue::OBJECT);
+        writer.write<uint32_t>(count);
+        for (uint32_t i = 0; i < count; i++) {
+            napi_value name;
+            napi_value property;
+            maybeThrowFromStatus(napi_get_element(env, names, i, &name), "Failed to retrieve property name");
+            maybeThrowFromStatus(napi_get_property(env, value, name, &property), "Failed to retrieve property from object");
+            size_t length;
+            maybeThrowFromStatus(napi_get_value_string_utf8(env, name, nullptr, 0, &length), "Failed to get the length of the string");
+            auto data = writer.allocateKey(length);
+            maybeThrowFromStatus(napi_get_value_string_utf8(env, name, data, length + 1, &length), "Failed to get the string data");
+            writeNapiValue(env, property, writer);
+        }
+        return TransferableValue::OBJECT;
+    }
+    default:
+        writer.write<uint8_t>(TransferableValue::NULL_VALUE);
+        return TransferableValue::NULL_VALUE;
+    }
+}
+
+napi_value readNapiValue(napi_env env, Reader &reader) {
+    auto type = reader.read<uint8_t>();
+    napi_value result;
+    switch (type) {
+    case TransferableValue::NULL_VALUE:
+        napi_get_undefined(env, &result);
+        return result;
+    case TransferableValue::FALSE_VALUE:
+    case TransferableValue::TRUE_VALUE:
+        napi_get_boolean(env, type == TransferableValue::TRUE_VALUE, &result);
+        return result;
+    case TransferableValue::NUMBER:
+        napi_create_double(env, reader.read<double>(), &result);
+        return result;
+    case TransferableValue::SHORT_STRING:
+    case TransferableValue::STRING: {
+        auto str = reader.readString(type);
+        maybeThrowFromStatus(napi_create_string_utf8(env, str.data(), str.size(), &result), "Failed to create string");
+        return result;
+    }
+    case TransferableValue::ARRAY:
+    case TransferableValue::NUMBER_ARRAY: {
+        auto count = reader.read<uint32_t>();
+        maybeThrowFromStatus(napi_create_array_with_length(env, count, &result), "Failed to create array");
+        for (uint32_t i = 0; i < count; i++) {
+            napi_value item;
+            if (type == TransferableValue::NUMBER_ARRAY) {
+                napi_create_double(env, reader.read<double>(), &item);
+            } else {
+                item = readNapiValue(env, reader);
+            }
+            napi_set_element(env, result, i, item);
+        }
+        return result;
+    }
+    case TransferableValue::OBJECT: {
+        auto count = reader.read<uint32_t>();
+        maybeThrowFromStatus(napi_create_object(env, &result), "Failed to create an object");
+        if (count == 0) {
+            return result;
+        }
+        // NOTE: all properties are defined in one call; names point into the buffer
+        std::vector<napi_property_descriptor> properties;
+        properties.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            auto key = reader.readKey();
+            properties.push_back(napi_property_descriptor{
+                key.data(), nullptr, nullptr, nullptr, nullptr, readNapiValue(env, reader), napi_default_jsproperty, nullptr});
+        }
+        maybeThrowFromStatus(napi_define_properties(env, result, properties.size(), properties.data()), "Failed to create an object");
+        return result;
+    }
+    default:
+        throw std::runtime_error("Unknown transferable value type: " + std::to_string(type));
+    }
+}
+
+jsi::Value readJsiValue(jsi::Runtime &rt, Reader &reader) {
+    auto type = reader.read<uint8_t>();
+    switch (type) {
+    case TransferableValue::NULL_VALUE:
+        return jsi::Value::null();
+    case TransferableValue::FALSE_VALUE:
+        return jsi::Value(false);
+    case TransferableValue::TRUE_VALUE:
+        return jsi::Value(true);
+    case TransferableValue::NUMBER:
+        return jsi::Value(reader.read<double>());
+    case TransferableValue::SHORT_STRING:
+    case TransferableValue::STRING: {
+        auto str = reader.readString(type);
+        return jsi::String::createFromUtf8(rt, reinterpret_cast<uint8_t const *>(str.data()), str.size());
+    }
+    case TransferableValue::ARRAY:
+    case TransferableValue::NUMBER_ARRAY: {
+        auto count = reader.read<uint32_t>();
+        jsi::Array array(rt, count);
+        for (uint32_t i = 0; i < count; i++) {
+            if (type == TransferableValue::NUMBER_ARRAY) {
+                array.setValueAtIndex(rt, i, jsi::Value(reader.read<double>()));
+            } else {
+                array.setValueAtIndex(rt, i, readJsiValue(rt, reader));
+            }
+        }
+        return jsi::Value(std::move(array));
+    }
+    case TransferableValue::OBJECT: {
+        auto count = reader.read<uint32_t>();
+        jsi::Object object(rt);
+        for (uint32_t i = 0; i < count; i++) {
+            auto key = reader.readKey();
+            auto name = jsi::PropNameID::forUtf8(rt, reinterpret_cast<uint8_t const *>(key.data()), key.size());
+            object.setProperty(rt, name, readJsiValue(rt, reader));
+        }
+        return jsi::Value(std::move(object));
+    }
+    default:
+        throw std::runtime_error("Unknown transferable value type: " + std::to_string(type));
+    }
+}
+
+} // namespace
+
+TransferableValue TransferableValue::fromJsi(jsi::Runtime &rt, jsi::Value const &value) {
+    TransferableValue result;
+    Writer writer(result.m_buffer);
+    writeJsiValue(rt, value, writer);
+    return result;
+}
+
+TransferableValue TransferableValue::fromNapi(napi_env env, napi_value value) {
+    TransferableValue result;
+    Writer writer(result.m_buffer);
+    writeNapiValue(env, value, writer);
+    return result;
+}
+
+napi_value TransferableValue::toNapi(napi_env env) const {
+    if (m_buffer.empty()) {
+        napi_value result;
+        napi_get_undefined(env, &result);
+        return result;
+    }
+    Reader reader(m_buffer);
+    return readNapiValue(env, reader);
+}
+
+jsi::Value TransferableValue::toJsi(jsi::Runtime &rt) const {
+    if (m_buffer.empty()) {
+        return jsi::Value::undefined();
+    }
+    Reader reader(m_buffer);
+    return readJsiValue(rt, reader);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <napi/native_api.h>
+
+namespace facebook::jsi {
+class Runtime;
+class Value;
+} // namespace facebook::jsi
+
+namespace rnoh {
+
+/**
+ * A JSON-like value copied out of one JS engine, to be recreated in the other one, possibly on another thread.
+ * Converts between JSI and NAPI values directly, instead of going through a folly::dynamic tree: the value is
+ * encoded depth-first into a single buffer, and strings and property names are read from it in place.
+ *
+ * Layout: tagged values (ValueType). Strings are u8 (SHORT_STRING) or u32 (STRING) byteLength, UTF-8 bytes and a
+ * NUL terminator. ARRAY is u32 count and tagged items; arrays of numbers only are NUMBER_ARRAY: u32 count and f64s.
+ * OBJECT is u32 count and (u32 byteLength, UTF-8 bytes, NUL, tagged value) properties.
+ *
+ * Conversions follow folly::dynamic's: undefined becomes null, undefined object properties are skipped,
+ * function properties become null, and other functions, symbols and BigInts throw.
+ */
+class TransferableValue {
+  public:
+    enum ValueType : uint8_t {
+        NULL_VALUE = 0,
+        FALSE_VALUE = 1,
+        TRUE_VALUE = 2,
+        NUMBER = 3,
+        SHORT_STRING = 4,
+        STRING = 5,
+        ARRAY = 6,
+        NUMBER_ARRAY = 7,
+        OBJECT = 8,
+    };
+
+    TransferableValue() = default;
+
+    static TransferableValue fromJsi(facebook::jsi::Runtime &rt, facebook::jsi::Value const &value);
+
+    /**
+     * Non-JSON values (functions, symbols, etc.) become null.
+     */
+    static TransferableValue fromNapi(napi_env env, napi_value value);
+
+    /**
+     * NOTE: null becomes undefined, as it does when a folly::dynamic is converted with ArkJS::createFromDynamic
+     */
+    napi_value toNapi(napi_env env) const;
+
+    facebook::jsi::Value toJsi(facebook::jsi::Runtime &rt) const;
+
+    size_t getSizeInBytes() const {
+        return m_buffer.size();
+    }
+
+  private:
+    std::vector<uint8_t> m_buffer;
+};
+
+} // namespace rnoh
@@ -10,24 +10,32 @@ TurboModuleFactory::TurboModuleFactory(napi_env env,
                                        napi_ref arkTsTurboModuleProviderRef,
                                        const ComponentJSIBinderByString &&componentBinderByString,
                                        std::shared_ptr<TaskExecutor> taskExecutor,
-                                       std::vector<std::shared_ptr<TurboModuleFactoryDelegate>> delegates)
+                                       std::vector<std::shared_ptr<TurboModuleFactoryDelegate>> delegates,
+                                       ArkTSCallQueue::Shared arkTsCallQueue,
+                                       FrameClock::Shared frameClock)
     : m_env(env),
       m_arkTsTurboModuleProviderRef(arkTsTurboModuleProviderRef),
       m_componentBinderByString(std::move(componentBinderByString)),
       m_taskExecutor(taskExecutor),
-      m_delegates(delegates) {}
+      m_delegates(delegates),
+      m_arkTsCallQueue(std::move(arkTsCallQueue)),
+      m_frameClock(std::move(frameClock)) {}
 
 TurboModuleFactory::SharedTurboModule TurboModuleFactory::create(
     std::shared_ptr<facebook::react::CallInvoker> jsInvoker,
     const std::string &name,
-    std::shared_ptr<EventDispatcher> eventDispatcher) const {
+    std::shared_ptr<EventDispatcher> eventDispatcher,
+    std::weak_ptr<facebook::react::Instance> instance) const {
     LOG(INFO) << "Providing Turbo Module: " << name;
     Context ctx{
         {.jsInvoker = jsInvoker},
         .env = m_env,
         .arkTsTurboModuleInstanceRef = this->maybeGetArkTsTurboModuleInstanceRef(name),
         .taskExecutor = m_taskExecutor,
-        .eventDispatcher = eventDispatcher};
+        .eventDispatcher = eventDispatcher,
+        .arkTsCallQueue = m_arkTsCallQueue,
+        .frameClock = m_frameClock,
+        .instance = instance};
     if (name == "UIManager") {
         return std::make_shared<UIManagerModule>(ctx, name, std::move(m_componentBinderByString));
     } else {
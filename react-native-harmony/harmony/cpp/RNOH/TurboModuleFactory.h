@@ -26,11 +26,14 @@ class TurboModuleFactory {
                        napi_ref arkTsTurboModuleProviderRef,
                        const ComponentJSIBinderByString &&,
                        std::shared_ptr<TaskExecutor>,
-                       std::vector<std::shared_ptr<TurboModuleFactoryDelegate>>);
+                       std::vector<std::shared_ptr<TurboModuleFactoryDelegate>>,
+                       ArkTSCallQueue::Shared,
+                       FrameClock::Shared);
 
     virtual SharedTurboModule create(std::shared_ptr<facebook::react::CallInvoker> jsInvoker,
                                      const std::string &name,
-                                     std::shared_ptr<EventDispatcher> eventDispatcher) const;
+                                     std::shared_ptr<EventDispatcher> eventDispatcher,
+                                     std::weak_ptr<facebook::react::Instance> instance) const;
 
   protected:
     SharedTurboModule delegateCreatingTurboModule(Context ctx, const std::string &name) const;
@@ -44,6 +47,8 @@ class TurboModuleFactory {
     napi_ref m_arkTsTurboModuleProviderRef;
     std::shared_ptr<TaskExecutor> m_taskExecutor;
     std::vector<std::shared_ptr<TurboModuleFactoryDelegate>> m_delegates;
+    ArkTSCallQueue::Shared m_arkTsCallQueue;
+    FrameClock::Shared m_frameClock;
 };
 
 } // namespace rnoh
@@ -2,6 +2,7 @@
 
 #include <ReactCommon/TurboModuleBinding.h>
 #include <ReactCommon/LongLivedObject.h>
+#include "RNOH/AppLifecycleListener.h"
 #include "RNOH/LogSink.h"
 
 using namespace rnoh;
@@ -9,12 +10,13 @@ using namespace facebook;
 
 TurboModuleProvider::TurboModuleProvider(std::shared_ptr<react::CallInvoker> jsInvoker,
                                          TurboModuleFactory &&turboModuleFactory,
-                                         std::shared_ptr<EventDispatcher> eventDispatcher)
+                                         std::shared_ptr<EventDispatcher> eventDispatcher,
+                                         std::weak_ptr<react::Instance> instance)
     : m_jsInvoker(jsInvoker),
-      m_createTurboModule([eventDispatcher, factory = std::move(turboModuleFactory)](
+      m_createTurboModule([eventDispatcher, instance, factory = std::move(turboModuleFactory)](
                               std::string const &moduleName,
                               std::shared_ptr<react::CallInvoker> jsInvoker) -> std::shared_ptr<react::TurboModule> {
-          return factory.create(jsInvoker, moduleName, eventDispatcher);
+          return factory.create(jsInvoker, moduleName, eventDispatcher, instance);
       }) {}
 
 void TurboModuleProvider::installJSBindings(react::RuntimeExecutor runtimeExecutor) {
@@ -35,15 +37,56 @@ void TurboModuleProvider::installJSBindings(react::RuntimeExecutor runtimeExecut
 }
 
 std::shared_ptr<react::TurboModule> TurboModuleProvider::getTurboModule(std::string const &moduleName) {
-    if (m_cache.contains(moduleName)) {
+    if (auto turboModule = findTurboModule(moduleName)) {
         LOG(INFO) << "Cache hit. Providing '" << moduleName << "' Turbo Module";
-        return m_cache[moduleName];
+        return turboModule;
     }
     auto turboModule = m_createTurboModule(moduleName, m_jsInvoker);
     if (turboModule != nullptr) {
+        if (auto listener = std::dynamic_pointer_cast<AppLifecycleListener>(turboModule);
+            listener != nullptr && m_isInBackground.load()) {
+            listener->onBackground();
+        }
+        std::lock_guard lock(m_cacheMutex);
         m_cache[moduleName] = turboModule;
         return turboModule;
     }
     LOG(ERROR) << "Couldn't provide turbo module \"" << moduleName << "\"";
     return nullptr;
-}
\ No newline at end of file
+}
+
+std::shared_ptr<react::TurboModule> TurboModuleProvider::findTurboModule(std::string const &moduleName) {
+    std::lock_guard lock(m_cacheMutex);
+    if (auto it = m_cache.find(moduleName); it != m_cache.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+std::vector<std::shared_ptr<react::TurboModule>> TurboModuleProvider::getCreatedTurboModules() {
+    std::lock_guard lock(m_cacheMutex);
+    std::vector<std::shared_ptr<react::TurboModule>> result;
+    result.reserve(m_cache.size());
+    for (auto const &[name, turboModule] : m_cache) {
+        result.push_back(turboModule);
+    }
+    return result;
+}
+
+void TurboModuleProvider::onForeground() {
+    m_isInBackground = false;
+    for (auto const &turboModule : getCreatedTurboModules()) {
+        if (auto listener = std::dynamic_pointer_cast<AppLifecycleListener>(turboModule)) {
+            listener->onForeground();
+        }
+    }
+}
+
+void TurboModuleProvider::onBackground() {
+    m_isInBackground = true;
+    for (auto const &turboModule : getCreatedTurboModules()) {
+        if (auto listener = std::dynamic_pointer_cast<AppLifecycleListener>(turboModule)) {
+            listener->onBackground();
+        }
+    }
+}
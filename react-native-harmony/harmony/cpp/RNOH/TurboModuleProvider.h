@@ -1,5 +1,8 @@
 #pragma once
+#include <atomic>
 #include <functional>
+#include <mutex>
+#include <vector>
 #include <butter/map.h>
 #include <ReactCommon/TurboModule.h>
 #include <ReactCommon/RuntimeExecutor.h>
@@ -14,15 +17,33 @@ class TurboModuleProvider : public std::enable_shared_from_this<TurboModuleProvi
   public:
     TurboModuleProvider(std::shared_ptr<facebook::react::CallInvoker> jsInvoker,
                         TurboModuleFactory &&turboModuleFactory,
-                        std::shared_ptr<EventDispatcher> eventDispatcher);
+                        std::shared_ptr<EventDispatcher> eventDispatcher,
+                        std::weak_ptr<facebook::react::Instance> instance);
 
     std::shared_ptr<facebook::react::TurboModule> getTurboModule(std::string const &moduleName);
+    /**
+     * Returns the module if JS has already required it, without creating it. Can be called from any thread.
+     */
+    std::shared_ptr<facebook::react::TurboModule> findTurboModule(std::string const &moduleName);
+    /**
+     * Returns the modules JS has already required. Can be called from any thread.
+     */
+    std::vector<std::shared_ptr<facebook::react::TurboModule>> getCreatedTurboModules();
     void installJSBindings(facebook::react::RuntimeExecutor runtimeExecutor);
+    /**
+     * Notify the AppLifecycleListener modules JS has already required. Modules created later while in background are
+     * notified with `onBackground` when they are created. Must be called on the JS thread.
+     */
+    void onForeground();
+    void onBackground();
 
   private:
     std::shared_ptr<facebook::react::CallInvoker> m_jsInvoker;
     std::function<std::shared_ptr<facebook::react::TurboModule>(std::string const &, std::shared_ptr<facebook::react::CallInvoker>)> m_createTurboModule;
     facebook::butter::map<std::string, std::shared_ptr<facebook::react::TurboModule>> m_cache;
+    // NOTE: not held while creating modules, which may wait for the main thread
+    std::mutex m_cacheMutex;
+    std::atomic_bool m_isInBackground{false};
 };
 
 } // namespace rnoh
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
-#include <unordered_set>
+#include <unordered_map>
+#include <vector>
 #include <chrono>
 #include <future>
 #include <mutex>
@@ -13,41 +16,116 @@ class UITicker {
   public:
     static void scheduleNextTick(long long timestamp, void *data) {
         auto self = static_cast<UITicker *>(data);
-        self->tick();
+        self->tick(timestamp);
     }
 
     UITicker() : m_vsyncHandle("UITicker") {}
 
     using Shared = std::shared_ptr<UITicker>;
+    using FrameCallback = std::function<void(long long timestamp)>;
 
+    /**
+     * Calls `listener` on every frame until unsubscribed. Frames are requested only while there is at least one
+     * subscriber or pending frame callback, so an idle app doesn't wake up at display rate.
+     */
     std::function<void()> subscribe(int id, std::function<void()> &&listener) {
         std::lock_guard lock(listenersMutex);
-        auto listenersCount = m_listenerById.size();
         m_listenerById.insert_or_assign(id, std::move(listener));
-        if (listenersCount == 0) {
-            this->requestNextTick();
-        }
+        this->requestNextTickIfNeeded();
         return [id, this]() {
             std::lock_guard lock(listenersMutex);
             this->m_listenerById.erase(id);
         };
     }
 
+    /**
+     * Calls `callback` once, on the next frame, with the vsync timestamp in nanoseconds.
+     */
+    void requestFrameCallback(FrameCallback &&callback) {
+        std::lock_guard lock(listenersMutex);
+        m_frameCallbacks.push_back(std::move(callback));
+        this->requestNextTickIfNeeded();
+    }
+
+    /**
+     * Estimates when the next frame is due, based on the last vsync timestamp and the observed frame interval.
+     * Thread-safe.
+     */
+    std::chrono::steady_clock::time_point getNextFrameDeadline() const {
+        auto frameIntervalInNs = getFrameIntervalInNs();
+        auto lastVsyncTimestampInNs = m_lastVsyncTimestampInNs.load(std::memory_order_relaxed);
+        auto nowInNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count();
+        auto deadlineInNs = lastVsyncTimestampInNs + frameIntervalInNs;
+        if (deadlineInNs <= nowInNs) {
+            // NOTE: no vsync was received recently (e.g. there are no listeners), assume the frame starts now
+            deadlineInNs = nowInNs + frameIntervalInNs;
+        }
+        return std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadlineInNs));
+    }
+
+    /**
+     * Exponential moving average of the observed vsync interval. Thread-safe.
+     */
+    int64_t getFrameIntervalInNs() const {
+        return m_frameIntervalInNs.load(std::memory_order_relaxed);
+    }
+
   private:
     std::unordered_map<int, std::function<void()>> m_listenerById;
+    std::vector<FrameCallback> m_frameCallbacks;
     std::mutex listenersMutex;
+    bool m_isTickRequested = false;
     NativeVsyncHandle m_vsyncHandle;
+    // NOTE: vsync timestamps are CLOCK_MONOTONIC nanoseconds, the same clock steady_clock uses
+    std::atomic<int64_t> m_lastVsyncTimestampInNs{0};
+    std::atomic<int64_t> m_frameIntervalInNs{DEFAULT_FRAME_INTERVAL_IN_NS};
 
-    void requestNextTick() {
+    static constexpr int64_t DEFAULT_FRAME_INTERVAL_IN_NS = 16'666'667;
+    static constexpr int64_t MIN_FRAME_INTERVAL_IN_NS = 4'000'000;
+    static constexpr int64_t MAX_FRAME_INTERVAL_IN_NS = 50'000'000;
+
+    // NOTE: must be called with listenersMutex held
+    void requestNextTickIfNeeded() {
+        if (m_isTickRequested || (m_listenerById.empty() && m_frameCallbacks.empty())) {
+            return;
+        }
+        m_isTickRequested = true;
         m_vsyncHandle.requestFrame(scheduleNextTick, this);
     }
 
-    void tick() {
-        std::lock_guard lock(listenersMutex);
-        for (const auto &idAndListener : m_listenerById) {
-            idAndListener.second();
+    void recordVsync(int64_t timestampInNs) {
+        auto lastVsyncTimestampInNs = m_lastVsyncTimestampInNs.exchange(timestampInNs, std::memory_order_relaxed);
+        auto intervalInNs = timestampInNs - lastVsyncTimestampInNs;
+        // NOTE: skipped frames and pauses between subscriptions shouldn't skew the estimate
+        if (lastVsyncTimestampInNs == 0 || intervalInNs < MIN_FRAME_INTERVAL_IN_NS ||
+            intervalInNs > MAX_FRAME_INTERVAL_IN_NS) {
+            return;
         }
-        this->requestNextTick();
+        auto frameIntervalInNs = m_frameIntervalInNs.load(std::memory_order_relaxed);
+        m_frameIntervalInNs.store(frameIntervalInNs + (intervalInNs - frameIntervalInNs) / 8, std::memory_order_relaxed);
+    }
+
+    void tick(long long timestamp) {
+        recordVsync(timestamp);
+        std::vector<FrameCallback> frameCallbacks;
+        {
+            // NOTE: listeners are called with the lock held, so they aren't called anymore once unsubscribe returns
+            std::lock_guard lock(listenersMutex);
+            m_isTickRequested = false;
+            for (const auto &idAndListener : m_listenerById) {
+                idAndListener.second();
+            }
+            frameCallbacks = std::move(m_frameCallbacks);
+            m_frameCallbacks.clear();
+        }
+        // NOTE: one-shot callbacks are called without the lock, so they can request another frame
+        for (const auto &frameCallback : frameCallbacks) {
+            frameCallback(timestamp);
+        }
+        std::lock_guard lock(listenersMutex);
+        this->requestNextTickIfNeeded();
     }
 };
 
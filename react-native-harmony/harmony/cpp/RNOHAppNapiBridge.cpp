@@ -7,7 +7,9 @@
 #include <vector>
 #include <unordered_map>
 #include <mutex>
+#include <react/renderer/core/CoreFeatures.h>
 #include "RNOH/ArkJS.h"
+#include "RNOH/ArrayBufferJSBigString.h"
 #include "RNOH/RNInstance.h"
 #include "RNOH/LogSink.h"
 #include "RNOH/UITicker.h"
@@ -57,6 +59,40 @@ static napi_value getNextRNInstanceId(napi_env env, napi_callback_info info) {
     return ArkJS(env).createInt(id);
 }
 
+static HermesRuntimeConfig getHermesRuntimeConfig(ArkJS &arkJs, napi_value napiConfig) {
+    HermesRuntimeConfig config;
+    if (arkJs.getType(napiConfig) != napi_object) {
+        return config;
+    }
+    auto napiInitialHeapSize = arkJs.getObjectProperty(napiConfig, "initialHeapSizeInBytes");
+    if (arkJs.getType(napiInitialHeapSize) == napi_number) {
+        config.initialHeapSizeInBytes = static_cast<uint32_t>(arkJs.getDouble(napiInitialHeapSize));
+    }
+    auto napiMaxHeapSize = arkJs.getObjectProperty(napiConfig, "maxHeapSizeInBytes");
+    if (arkJs.getType(napiMaxHeapSize) == napi_number) {
+        config.maxHeapSizeInBytes = static_cast<uint32_t>(arkJs.getDouble(napiMaxHeapSize));
+    }
+    auto napiReleaseUnusedMemory = arkJs.getObjectProperty(napiConfig, "releaseUnusedMemory");
+    if (arkJs.getType(napiReleaseUnusedMemory) == napi_string) {
+        static const std::unordered_map<std::string, HermesRuntimeConfig::ReleaseUnusedMemory> releaseUnusedMemoryByName = {
+            {"NONE", HermesRuntimeConfig::ReleaseUnusedMemory::NONE},
+            {"OLD_GENERATION", HermesRuntimeConfig::ReleaseUnusedMemory::OLD_GENERATION},
+            {"YOUNG_GENERATION_ON_FULL_GC", HermesRuntimeConfig::ReleaseUnusedMemory::YOUNG_GENERATION_ON_FULL_GC},
+            {"YOUNG_GENERATION_ALWAYS", HermesRuntimeConfig::ReleaseUnusedMemory::YOUNG_GENERATION_ALWAYS},
+        };
+        auto it = releaseUnusedMemoryByName.find(arkJs.getString(napiReleaseUnusedMemory));
+        if (it != releaseUnusedMemoryByName.end()) {
+            config.releaseUnusedMemory = it->second;
+        }
+    }
+    auto napiShouldRecordGCStats = arkJs.getObjectProperty(napiConfig, "shouldRecordGCStats");
+    config.shouldRecordGCStats = arkJs.getType(napiShouldRecordGCStats) == napi_boolean && arkJs.getBoolean(napiShouldRecordGCStats);
+    auto napiShouldEvictBytecodePages = arkJs.getObjectProperty(napiConfig, "shouldEvictBytecodePagesOnMemoryPressure");
+    config.shouldEvictBytecodePagesOnMemoryPressure = arkJs.getType(napiShouldEvictBytecodePages) == napi_boolean &&
+                                                      arkJs.getBoolean(napiShouldEvictBytecodePages);
+    return config;
+}
+
 static napi_value createReactNativeInstance(napi_env env, napi_callback_info info) {
     LOG(INFO) << "createReactNativeInstance";
     ArkJS arkJs(env);
@@ -66,12 +102,27 @@ static napi_value createReactNativeInstance(napi_env env, napi_callback_info inf
     auto mutationsListenerRef = arkJs.createReference(args[2]);
     auto commandDispatcherRef = arkJs.createReference(args[3]);
     auto eventDispatcherRef = arkJs.createReference(args[4]);
-    auto measureTextFnRef = arkJs.createReference(args[5]);
+    auto mutationsTransport = MutationsTransport::OBJECTS;
+    auto isPropsDiffingEnabled = false;
+    auto isAnimationFrameRateThrottlingEnabled = false;
+    HermesRuntimeConfig hermesRuntimeConfig;
+    if (arkJs.getType(args[5]) == napi_object) {
+        auto napiMutationsTransport = arkJs.getObjectProperty(args[5], "mutationsTransport");
+        if (arkJs.getType(napiMutationsTransport) == napi_string && arkJs.getString(napiMutationsTransport) == "BINARY") {
+            mutationsTransport = MutationsTransport::BINARY;
+        }
+        auto napiIsPropsDiffingEnabled = arkJs.getObjectProperty(args[5], "isPropsDiffingEnabled");
+        isPropsDiffingEnabled = arkJs.getType(napiIsPropsDiffingEnabled) == napi_boolean && arkJs.getBoolean(napiIsPropsDiffingEnabled);
+        auto napiIsAnimationFrameRateThrottlingEnabled = arkJs.getObjectProperty(args[5], "isAnimationFrameRateThrottlingEnabled");
+        isAnimationFrameRateThrottlingEnabled = arkJs.getType(napiIsAnimationFrameRateThrottlingEnabled) == napi_boolean &&
+                                                arkJs.getBoolean(napiIsAnimationFrameRateThrottlingEnabled);
+        hermesRuntimeConfig = getHermesRuntimeConfig(arkJs, arkJs.getObjectProperty(args[5], "hermesRuntimeConfig"));
+    }
     auto rnInstance = createRNInstance(
         instanceId,
         env,
         arkTsTurboModuleProviderRef,
-        [env, instanceId, mutationsListenerRef](MutationsToNapiConverter mutationsToNapiConverter, auto const &mutations) {
+        [env, instanceId, mutationsListenerRef](MutationsToNapiConverter mutationsToNapiConverter, auto const &mutations, auto binaryMutations) {
             {
                 auto lock = std::lock_guard<std::mutex>(rnInstanceByIdMutex);
                 if (rnInstanceById.find(instanceId) == rnInstanceById.end()) {
@@ -80,9 +131,13 @@ static napi_value createReactNativeInstance(napi_env env, napi_callback_info inf
                 }
             }
             ArkJS arkJs(env);
+            auto listener = arkJs.getReferenceValue(mutationsListenerRef);
+            if (binaryMutations != nullptr) {
+                arkJs.call<2>(listener, mutationsToNapiConverter.convert(env, mutations, std::move(binaryMutations)));
+                return;
+            }
             auto napiMutations = mutationsToNapiConverter.convert(env, mutations);
             std::array<napi_value, 1> args = {napiMutations};
-            auto listener = arkJs.getReferenceValue(mutationsListenerRef);
             arkJs.call<1>(listener, args);
         },
         [env, instanceId, commandDispatcherRef](auto tag, auto const &commandName, auto args) {
@@ -99,9 +154,12 @@ static napi_value createReactNativeInstance(napi_env env, napi_callback_info inf
             auto commandDispatcher = arkJs.getReferenceValue(commandDispatcherRef);
             arkJs.call<3>(commandDispatcher, napiArgsArray);
         },
-        measureTextFnRef,
         eventDispatcherRef,
-        uiTicker);
+        uiTicker,
+        mutationsTransport,
+        isPropsDiffingEnabled,
+        isAnimationFrameRateThrottlingEnabled,
+        hermesRuntimeConfig);
 
     auto lock = std::lock_guard<std::mutex>(rnInstanceByIdMutex);
     if (rnInstanceById.find(instanceId) != rnInstanceById.end()) {
@@ -131,6 +189,18 @@ static napi_value destroyReactNativeInstance(napi_env env, napi_callback_info in
     return arkJs.getUndefined();
 }
 
+static std::function<void(const std::string)> createLoadScriptFinishCallback(napi_env env, TaskExecutor::Shared taskExecutor, napi_value onFinish) {
+    auto onFinishRef = ArkJS(env).createReference(onFinish);
+    return [taskExecutor, env, onFinishRef](const std::string errorMsg) {
+        taskExecutor->runTask(TaskThread::MAIN, [env, onFinishRef, errorMsg = std::move(errorMsg)]() {
+            ArkJS arkJs(env);
+            auto listener = arkJs.getReferenceValue(onFinishRef);
+            arkJs.call<1>(listener, {arkJs.createString(errorMsg)});
+            arkJs.deleteReference(onFinishRef);
+        });
+    };
+}
+
 static napi_value loadScript(napi_env env, napi_callback_info info) {
     LOG(INFO) << "loadScript";
     ArkJS arkJs(env);
@@ -142,18 +212,46 @@ static napi_value loadScript(napi_env env, napi_callback_info info) {
         return arkJs.getUndefined();
     }
     auto &rnInstance = it->second;
-    auto onFinishRef = arkJs.createReference(args[3]);
     rnInstance->loadScript(
-        arkJs.getArrayBuffer(args[1]),
+        std::make_unique<ArrayBufferJSBigString>(env, args[1], rnInstance->taskExecutor),
         arkJs.getString(args[2]),
-        [taskExecutor = rnInstance->taskExecutor, env, onFinishRef](const std::string errorMsg) {
-            taskExecutor->runTask(TaskThread::MAIN, [env, onFinishRef, errorMsg = std::move(errorMsg)]() {
-                ArkJS arkJs(env);
-                auto listener = arkJs.getReferenceValue(onFinishRef);
-                arkJs.call<1>(listener, {arkJs.createString(errorMsg)});
-                arkJs.deleteReference(onFinishRef);
-            });
-        });
+        createLoadScriptFinishCallback(env, rnInstance->taskExecutor, args[3]));
+    return arkJs.getUndefined();
+}
+
+static napi_value loadScriptFromFile(napi_env env, napi_callback_info info) {
+    LOG(INFO) << "loadScriptFromFile";
+    ArkJS arkJs(env);
+    auto args = arkJs.getCallbackArgs(info, 4);
+    size_t instanceId = arkJs.getDouble(args[0]);
+    auto lock = std::lock_guard<std::mutex>(rnInstanceByIdMutex);
+    auto it = rnInstanceById.find(instanceId);
+    if (it == rnInstanceById.end()) {
+        return arkJs.getUndefined();
+    }
+    auto &rnInstance = it->second;
+    rnInstance->loadScriptFromFile(
+        arkJs.getString(args[1]),
+        arkJs.getString(args[2]),
+        createLoadScriptFinishCallback(env, rnInstance->taskExecutor, args[3]));
+    return arkJs.getUndefined();
+}
+
+static napi_value registerSegment(napi_env env, napi_callback_info info) {
+    LOG(INFO) << "registerSegment";
+    ArkJS arkJs(env);
+    auto args = arkJs.getCallbackArgs(info, 4);
+    size_t instanceId = arkJs.getDouble(args[0]);
+    auto lock = std::lock_guard<std::mutex>(rnInstanceByIdMutex);
+    auto it = rnInstanceById.find(instanceId);
+    if (it == rnInstanceById.end()) {
+        return arkJs.getUndefined();
+    }
+    auto &rnInstance = it->second;
+    rnInstance->registerSegment(
+        static_cast<uint32_t>(arkJs.getDouble(args[1])),
+        arkJs.getString(args[2]),
+        createLoadScriptFinishCallback(env, rnInstance->taskExecutor, args[3]));
     return arkJs.getUndefined();
 }
 
@@ -329,6 +427,160 @@ static napi_value onMemoryLevel(napi_env env, napi_callback_info info) {
     return arkJs.getUndefined();
 }
 
+static napi_value onForeground(napi_env env, napi_callback_info info) {
+    ArkJS arkJs(env);
+    auto args = arkJs.getCallbackArgs(info, 1);
+    size_t instanceId = arkJs.getDouble(args[0]);
+    auto lock = std::lock_guard<std::mutex>(rnInstanceByIdMutex);
+    auto it = rnInstanceById.find(instanceId);
+    if (it == rnInstanceById.end()) {
+        return arkJs.getUndefined();
+    }
+    it->second->onForeground();
+    return arkJs.getUndefined();
+}
+
+static napi_value onBackground(napi_env env, napi_callback_info info) {
+    ArkJS arkJs(env);
+    auto args = arkJs.getCallbackArgs(info, 1);
+    size_t instanceId = arkJs.getDouble(args[0]);
+    auto lock = std::lock_guard<std::mutex>(rnInstanceByIdMutex);
+    auto it = rnInstanceById.find(instanceId);
+    if (it == rnInstanceById.end()) {
+        return arkJs.getUndefined();
+    }
+    it->second->onBackground();
+    return arkJs.getUndefined();
+}
+
+static napi_value getTextMeasurementCacheStats(napi_env env, napi_callback_info info) {
+    ArkJS arkJs(env);
+    auto args = arkJs.getCallbackArgs(info, 1);
+    size_t instanceId = arkJs.getDouble(args[0]);
+    auto lock = std::lock_guard<std::mutex>(rnInstanceByIdMutex);
+    auto it = rnInstanceById.find(instanceId);
+    if (it == rnInstanceById.end()) {
+        return arkJs.getUndefined();
+    }
+    auto stats = it->second->getTextMeasurementCacheStats();
+    if (!stats.has_value()) {
+        return arkJs.getUndefined();
+    }
+    return arkJs.createObjectBuilder()
+        .addProperty("hitsCount", static_cast<double>(stats->hitsCount))
+        .addProperty("missesCount", static_cast<double>(stats->missesCount))
+        .addProperty("evictionsCount", static_cast<double>(stats->evictionsCount))
+        .addProperty("entriesCount", static_cast<double>(stats->entriesCount))
+        .addProperty("sizeInBytes", static_cast<double>(stats->sizeInBytes))
+        .addProperty("maxSizeInBytes", static_cast<double>(stats->maxSizeInBytes))
+        .build();
+}
+
+static napi_value createTaskLaneStatsObject(ArkJS &arkJs, std::vector<TaskLaneStats> const &laneStats) {
+    static constexpr std::array<const char *, TASK_PRIORITIES_COUNT> laneNames = {
+        "INPUT", "ANIMATION", "MOUNT", "NORMAL", "IDLE"};
+    auto createHistogram = [&arkJs](auto const &counts) {
+        std::vector<napi_value> values;
+        values.reserve(counts.size());
+        for (auto count : counts) {
+            values.push_back(arkJs.createDouble(static_cast<double>(count)));
+        }
+        return arkJs.createArray(values);
+    };
+    auto builder = arkJs.createObjectBuilder();
+    for (size_t i = 0; i < laneStats.size() && i < laneNames.size(); i++) {
+        builder.addProperty(laneNames[i], arkJs.createObjectBuilder()
+                                              .addProperty("queueDepth", static_cast<double>(laneStats[i].queueDepth))
+                                              .addProperty("queueDepthHistogram", createHistogram(laneStats[i].queueDepthHistogram))
+                                              .addProperty("waitTimeInUsHistogram", createHistogram(laneStats[i].waitTimeInUsHistogram))
+                                              .build());
+    }
+    return builder.build();
+}
+
+static napi_value getTaskLaneStats(napi_env env, napi_callback_info info) {
+    ArkJS arkJs(env);
+    auto args = arkJs.getCallbackArgs(info, 1);
+    size_t instanceId = arkJs.getDouble(args[0]);
+    auto lock = std::lock_guard<std::mutex>(rnInstanceByIdMutex);
+    auto it = rnInstanceById.find(instanceId);
+    if (it == rnInstanceById.end()) {
+        return arkJs.getUndefined();
+    }
+    auto &taskExecutor = it->second->taskExecutor;
+    return arkJs.createObjectBuilder()
+        .addProperty("MAIN", createTaskLaneStatsObject(arkJs, taskExecutor->getTaskLaneStats(TaskThread::MAIN)))
+        .addProperty("JS", createTaskLaneStatsObject(arkJs, taskExecutor->getTaskLaneStats(TaskThread::JS)))
+        .build();
+}
+
+static napi_value getAnimationTelemetry(napi_env env, napi_callback_info info) {
+    ArkJS arkJs(env);
+    auto args = arkJs.getCallbackArgs(info, 1);
+    size_t instanceId = arkJs.getDouble(args[0]);
+    std::shared_ptr<AnimationTelemetryProvider> animationTelemetryProvider;
+    {
+        auto lock = std::lock_guard<std::mutex>(rnInstanceByIdMutex);
+        auto it = rnInstanceById.find(instanceId);
+        if (it == rnInstanceById.end()) {
+            return arkJs.getUndefined();
+        }
+        animationTelemetryProvider = it->second->getAnimationTelemetryProvider();
+    }
+    if (animationTelemetryProvider == nullptr) {
+        return arkJs.getUndefined();
+    }
+    // NOTE: waits for the animation thread, so it's called without holding rnInstanceByIdMutex
+    auto animationsTelemetry = animationTelemetryProvider->getAnimationTelemetry();
+    std::vector<napi_value> napiAnimationsTelemetry;
+    napiAnimationsTelemetry.reserve(animationsTelemetry.size());
+    for (auto const &telemetry : animationsTelemetry) {
+        napiAnimationsTelemetry.push_back(
+            arkJs.createObjectBuilder()
+                .addProperty("animationId", static_cast<double>(telemetry.animationId))
+                .addProperty("nodeTag", static_cast<double>(telemetry.nodeTag))
+                .addProperty("type", telemetry.type)
+                .addProperty("isRunning", telemetry.isRunning)
+                .addProperty("hasCompleted", telemetry.hasCompleted)
+                .addProperty("framesCount", static_cast<double>(telemetry.framesCount))
+                .addProperty("droppedFramesCount", static_cast<double>(telemetry.droppedFramesCount))
+                .addProperty("clampedFramesCount", static_cast<double>(telemetry.clampedFramesCount))
+                .addProperty("maxFrameDeltaInMs", telemetry.maxFrameDeltaInNs / 1e6)
+                .addProperty("totalEvaluationTimeInMs", telemetry.totalEvaluationTimeInNs / 1e6)
+                .addProperty("maxEvaluationTimeInMs", telemetry.maxEvaluationTimeInNs / 1e6)
+                .build());
+    }
+    return arkJs.createArray(napiAnimationsTelemetry);
+}
+
+static napi_value getHermesHeapInfo(napi_env env, napi_callback_info info) {
+    ArkJS arkJs(env);
+    auto args = arkJs.getCallbackArgs(info, 3);
+    size_t instanceId = arkJs.getDouble(args[0]);
+    auto lock = std::lock_guard<std::mutex>(rnInstanceByIdMutex);
+    auto it = rnInstanceById.find(instanceId);
+    if (it == rnInstanceById.end()) {
+        arkJs.call<1>(args[2], {arkJs.createObjectBuilder().build()});
+        return arkJs.getUndefined();
+    }
+    auto &rnInstance = it->second;
+    auto onResultRef = arkJs.createReference(args[2]);
+    rnInstance->getHermesHeapInfo(
+        arkJs.getBoolean(args[1]),
+        [taskExecutor = rnInstance->taskExecutor, env, onResultRef](auto heapInfo) {
+            taskExecutor->runTask(TaskThread::MAIN, [env, onResultRef, heapInfo = std::move(heapInfo)] {
+                ArkJS arkJs(env);
+                auto napiHeapInfo = arkJs.createObjectBuilder();
+                for (auto const &[name, value] : heapInfo) {
+                    napiHeapInfo.addProperty(name.c_str(), static_cast<double>(value));
+                }
+                arkJs.call<1>(arkJs.getReferenceValue(onResultRef), {napiHeapInfo.build()});
+                arkJs.deleteReference(onResultRef);
+            });
+        });
+    return arkJs.getUndefined();
+}
+
 static napi_value updateState(napi_env env, napi_callback_info info) {
     ArkJS arkJs(env);
     auto args = arkJs.getCallbackArgs(info, 4);
@@ -348,12 +600,17 @@ static napi_value updateState(napi_env env, napi_callback_info info) {
 
 EXTERN_C_START
 static napi_value Init(napi_env env, napi_value exports) {
+    // NOTE: CoreFeatures are process-wide, so they are set once when the module is loaded, rather than per RNInstance.
+    // This one makes ParagraphLayoutManager keep the laid-out typography from TextMeasurer::getHostTextStorage.
+    facebook::react::CoreFeatures::cacheNSTextStorage = true;
     napi_property_descriptor desc[] = {
         {"onInit", nullptr, onInit, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"getNextRNInstanceId", nullptr, getNextRNInstanceId, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"createReactNativeInstance", nullptr, createReactNativeInstance, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"destroyReactNativeInstance", nullptr, destroyReactNativeInstance, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"loadScript", nullptr, loadScript, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"loadScriptFromFile", nullptr, loadScriptFromFile, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"registerSegment", nullptr, registerSegment, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"startSurface", nullptr, startSurface, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"stopSurface", nullptr, stopSurface, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"destroySurface", nullptr, destroySurface, nullptr, nullptr, nullptr, napi_default, nullptr},
@@ -363,6 +620,12 @@ static napi_value Init(napi_env env, napi_value exports) {
         {"emitComponentEvent", nullptr, emitComponentEvent, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"callRNFunction", nullptr, callRNFunction, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"onMemoryLevel", nullptr, onMemoryLevel, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"onForeground", nullptr, onForeground, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"onBackground", nullptr, onBackground, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"getTextMeasurementCacheStats", nullptr, getTextMeasurementCacheStats, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"getTaskLaneStats", nullptr, getTaskLaneStats, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"getAnimationTelemetry", nullptr, getAnimationTelemetry, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"getHermesHeapInfo", nullptr, getHermesHeapInfo, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"updateState", nullptr, updateState, nullptr, nullptr, nullptr, napi_default, nullptr}};
 
     napi_define_properties(env, exports, sizeof(desc) / sizeof(napi_property_descriptor), desc);
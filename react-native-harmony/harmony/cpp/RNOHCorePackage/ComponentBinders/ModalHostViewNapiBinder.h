@@ -54,9 +54,10 @@ class ModalHostViewNapiBinder : public ViewComponentNapiBinder {
         if (modalState == nullptr) {
             return;
         }
-        auto screenSize = arkJs.getObjectProperty(newState, "screenSize");
-        auto width = arkJs.getObjectProperty(screenSize, "width");
-        auto height = arkJs.getObjectProperty(screenSize, "height");
+        static auto const SCREEN_SIZE_KEY = PropertyKey::intern("screenSize");
+        auto screenSize = arkJs.getObjectProperty(newState, SCREEN_SIZE_KEY);
+        auto width = arkJs.getObjectProperty(screenSize, PropertyKeys::WIDTH);
+        auto height = arkJs.getObjectProperty(screenSize, PropertyKeys::HEIGHT);
         facebook::react::ModalHostViewState data(facebook::react::Size{
             (facebook::react::Float)arkJs.getDouble(width),
             (facebook::react::Float)arkJs.getDouble(height)});
@@ -59,8 +59,10 @@ class ScrollViewComponentNapiBinder : public ViewComponentNapiBinder {
             return;
         }
 
-        auto contentOffsetX = arkJs.getObjectProperty(ctx.newState, "contentOffsetX");
-        auto contentOffsetY = arkJs.getObjectProperty(ctx.newState, "contentOffsetY");
+        static auto const CONTENT_OFFSET_X_KEY = PropertyKey::intern("contentOffsetX");
+        static auto const CONTENT_OFFSET_Y_KEY = PropertyKey::intern("contentOffsetY");
+        auto contentOffsetX = arkJs.getObjectProperty(ctx.newState, CONTENT_OFFSET_X_KEY);
+        auto contentOffsetY = arkJs.getObjectProperty(ctx.newState, CONTENT_OFFSET_Y_KEY);
         auto contentOffset = facebook::react::Point{
             (facebook::react::Float)arkJs.getDouble(contentOffsetX),
             (facebook::react::Float)arkJs.getDouble(contentOffsetY)};
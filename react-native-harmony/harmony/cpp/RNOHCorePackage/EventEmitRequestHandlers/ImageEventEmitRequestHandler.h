@@ -14,9 +14,9 @@ class ImageEventEmitRequestHandler : public EventEmitRequestHandler {
     };
 
     ImageLoadEventSourceObject getImageLoadEventSourceObject(ArkJS &arkJs, napi_value eventObject) {
-        auto width = (float)(arkJs.getDouble(arkJs.getObjectProperty(eventObject, "width")));
-        auto height = (float)(arkJs.getDouble(arkJs.getObjectProperty(eventObject, "height")));
-        auto uri = arkJs.getString(arkJs.getObjectProperty(eventObject, "uri"));
+        auto width = (float)(arkJs.getDouble(arkJs.getObjectProperty(eventObject, PropertyKeys::WIDTH)));
+        auto height = (float)(arkJs.getDouble(arkJs.getObjectProperty(eventObject, PropertyKeys::HEIGHT)));
+        auto uri = arkJs.getString(arkJs.getObjectProperty(eventObject, PropertyKeys::URI));
         return {width, height, uri};
     }
 
@@ -15,22 +15,22 @@ enum ScrollEventType {
 };
 
 facebook::react::ScrollViewMetrics convertScrollEvent(ArkJS &arkJs, napi_value eventObject) {
-    auto arkContentSize = arkJs.getObjectProperty(eventObject, "contentSize");
+    auto arkContentSize = arkJs.getObjectProperty(eventObject, PropertyKeys::CONTENT_SIZE);
     facebook::react::Size contentSize = {
-        (float)arkJs.getDouble(arkJs.getObjectProperty(arkContentSize, "width")),
-        (float)arkJs.getDouble(arkJs.getObjectProperty(arkContentSize, "height"))};
+        (float)arkJs.getDouble(arkJs.getObjectProperty(arkContentSize, PropertyKeys::WIDTH)),
+        (float)arkJs.getDouble(arkJs.getObjectProperty(arkContentSize, PropertyKeys::HEIGHT))};
 
-    auto arkContentOffset = arkJs.getObjectProperty(eventObject, "contentOffset");
+    auto arkContentOffset = arkJs.getObjectProperty(eventObject, PropertyKeys::CONTENT_OFFSET);
     facebook::react::Point contentOffset = {
-        (float)arkJs.getDouble(arkJs.getObjectProperty(arkContentOffset, "x")),
-        (float)arkJs.getDouble(arkJs.getObjectProperty(arkContentOffset, "y"))};
+        (float)arkJs.getDouble(arkJs.getObjectProperty(arkContentOffset, PropertyKeys::X)),
+        (float)arkJs.getDouble(arkJs.getObjectProperty(arkContentOffset, PropertyKeys::Y))};
 
-    auto arkContainerSize = arkJs.getObjectProperty(eventObject, "containerSize");
+    auto arkContainerSize = arkJs.getObjectProperty(eventObject, PropertyKeys::CONTAINER_SIZE);
     facebook::react::Size containerSize = {
-        (float)arkJs.getDouble(arkJs.getObjectProperty(arkContainerSize, "width")),
-        (float)arkJs.getDouble(arkJs.getObjectProperty(arkContainerSize, "height"))};
+        (float)arkJs.getDouble(arkJs.getObjectProperty(arkContainerSize, PropertyKeys::WIDTH)),
+        (float)arkJs.getDouble(arkJs.getObjectProperty(arkContainerSize, PropertyKeys::HEIGHT))};
 
-    float zoomScale = (float)arkJs.getDouble(arkJs.getObjectProperty(eventObject, "zoomScale"));
+    float zoomScale = (float)arkJs.getDouble(arkJs.getObjectProperty(eventObject, PropertyKeys::ZOOM_SCALE));
 
     return {
         contentSize,
@@ -6,8 +6,8 @@
 namespace rnoh {
 
 facebook::react::SwitchEventEmitter::OnChange convertSwitchEvent(ArkJS &arkJs, napi_value eventObject) {
-    auto value = arkJs.getBoolean(arkJs.getObjectProperty(eventObject, "value"));
-    auto target = arkJs.getInteger(arkJs.getObjectProperty(eventObject, "target"));
+    auto value = arkJs.getBoolean(arkJs.getObjectProperty(eventObject, PropertyKeys::VALUE));
+    auto target = arkJs.getInteger(arkJs.getObjectProperty(eventObject, PropertyKeys::TARGET));
 
     return {value, target};
 }
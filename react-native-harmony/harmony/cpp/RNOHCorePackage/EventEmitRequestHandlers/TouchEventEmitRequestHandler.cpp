@@ -14,13 +14,13 @@ void TouchEventEmitRequestHandler::handleEvent(TouchEventEmitRequestHandler::Con
     ArkJS arkJs(ctx.env);
     auto touchEvent = ctx.payload;
 
-    auto timestampNanos = arkJs.getDouble(arkJs.getObjectProperty(touchEvent, "timestamp"));
+    auto timestampNanos = arkJs.getDouble(arkJs.getObjectProperty(touchEvent, PropertyKeys::TIMESTAMP));
     react::Float timestamp = timestampNanos / 1e6;
 
-    auto touches = convertTouches(arkJs, ctx.tag, timestamp, arkJs.getObjectProperty(touchEvent, "touches"));
-    auto changedTouches = convertTouches(arkJs, ctx.tag, timestamp, arkJs.getObjectProperty(touchEvent, "changedTouches"));
+    auto touches = convertTouches(arkJs, ctx.tag, timestamp, arkJs.getObjectProperty(touchEvent, PropertyKeys::TOUCHES));
+    auto changedTouches = convertTouches(arkJs, ctx.tag, timestamp, arkJs.getObjectProperty(touchEvent, PropertyKeys::CHANGED_TOUCHES));
 
-    auto eventType = (TouchType)(arkJs.getDouble(arkJs.getObjectProperty(ctx.payload, "type")));
+    auto eventType = (TouchType)(arkJs.getDouble(arkJs.getObjectProperty(ctx.payload, PropertyKeys::TYPE)));
     bool isTouchEnd = eventType == TouchType::UP || eventType == TouchType::CANCEL;
 
     std::unordered_set<react::Tag> changedTargets;
@@ -68,14 +68,14 @@ void TouchEventEmitRequestHandler::handleEvent(TouchEventEmitRequestHandler::Con
 }
 
 facebook::react::Touch TouchEventEmitRequestHandler::convertTouchObject(ArkJS &arkJs, napi_value touchObject) {
-    facebook::react::Tag id = arkJs.getDouble(arkJs.getObjectProperty(touchObject, "id"));
-    facebook::react::Tag target = arkJs.getDouble(arkJs.getObjectProperty(touchObject, "targetTag"));
-    facebook::react::Float screenX = arkJs.getDouble(arkJs.getObjectProperty(touchObject, "screenX"));
-    facebook::react::Float screenY = arkJs.getDouble(arkJs.getObjectProperty(touchObject, "screenY"));
-    facebook::react::Float pageX = arkJs.getDouble(arkJs.getObjectProperty(touchObject, "pageX"));
-    facebook::react::Float pageY = arkJs.getDouble(arkJs.getObjectProperty(touchObject, "pageY"));
-    facebook::react::Float x = arkJs.getDouble(arkJs.getObjectProperty(touchObject, "x"));
-    facebook::react::Float y = arkJs.getDouble(arkJs.getObjectProperty(touchObject, "y"));
+    facebook::react::Tag id = arkJs.getDouble(arkJs.getObjectProperty(touchObject, PropertyKeys::ID));
+    facebook::react::Tag target = arkJs.getDouble(arkJs.getObjectProperty(touchObject, PropertyKeys::TARGET_TAG));
+    facebook::react::Float screenX = arkJs.getDouble(arkJs.getObjectProperty(touchObject, PropertyKeys::SCREEN_X));
+    facebook::react::Float screenY = arkJs.getDouble(arkJs.getObjectProperty(touchObject, PropertyKeys::SCREEN_Y));
+    facebook::react::Float pageX = arkJs.getDouble(arkJs.getObjectProperty(touchObject, PropertyKeys::PAGE_X));
+    facebook::react::Float pageY = arkJs.getDouble(arkJs.getObjectProperty(touchObject, PropertyKeys::PAGE_Y));
+    facebook::react::Float x = arkJs.getDouble(arkJs.getObjectProperty(touchObject, PropertyKeys::X));
+    facebook::react::Float y = arkJs.getDouble(arkJs.getObjectProperty(touchObject, PropertyKeys::Y));
     return facebook::react::Touch{
         .pagePoint = {.x = pageX, .y = pageY},
         .offsetPoint = {.x = x, .y = y},
@@ -1,8 +1,11 @@
 #include "AnimatedNodesManager.h"
 
 #include <glog/logging.h>
-#include <queue>
+#include <hitrace/trace.h>
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <limits>
 
 #include "Nodes/StyleAnimatedNode.h"
 #include "Nodes/ValueAnimatedNode.h"
@@ -23,9 +26,11 @@ using namespace facebook;
 
 namespace rnoh {
 
-AnimatedNodesManager::AnimatedNodesManager(std::function<void()> &&scheduleUpdateFn, std::function<void(react::Tag, folly::dynamic)> &&setNativePropsFn)
+static constexpr size_t MAX_ENDED_ANIMATIONS_TELEMETRY_COUNT = 64;
+
+AnimatedNodesManager::AnimatedNodesManager(std::function<void()> &&scheduleUpdateFn, FlushPropsFn &&flushPropsFn)
     : m_scheduleUpdateFn(std::move(scheduleUpdateFn)),
-      m_setNativePropsFn(std::move(setNativePropsFn)) {}
+      m_flushPropsFn(std::move(flushPropsFn)) {}
 
 void AnimatedNodesManager::createNode(facebook::react::Tag tag, folly::dynamic const &config) {
     LOG(INFO) << "AnimatedNodesManager::createNode(" << tag <<", " << config << ")";
@@ -62,11 +67,12 @@ void AnimatedNodesManager::createNode(facebook::react::Tag tag, folly::dynamic c
 
     node->tag_ = tag;
     m_nodeByTag.insert({tag, std::move(node)});
-    m_nodeTagsToUpdate.insert(tag);
+    invalidateSchedule();
+    setNeedsUpdate(tag);
 }
 
 void AnimatedNodesManager::dropNode(facebook::react::Tag tag) {
-    m_nodeTagsToUpdate.erase(tag);
+    invalidateSchedule();
     m_nodeByTag.erase(tag);
 }
 
@@ -75,7 +81,8 @@ void AnimatedNodesManager::connectNodes(facebook::react::Tag parentTag, facebook
     auto &child = getNodeByTag(childTag);
 
     parent.addChild(child);
-    m_nodeTagsToUpdate.insert(childTag);
+    invalidateSchedule();
+    setNeedsUpdate(childTag);
 }
 
 void AnimatedNodesManager::disconnectNodes(facebook::react::Tag parentTag, facebook::react::Tag childTag) {
@@ -83,13 +90,14 @@ void AnimatedNodesManager::disconnectNodes(facebook::react::Tag parentTag, faceb
     auto &child = getNodeByTag(childTag);
 
     parent.removeChild(child);
-    m_nodeTagsToUpdate.insert(childTag);
+    invalidateSchedule();
+    setNeedsUpdate(childTag);
 }
 
 void AnimatedNodesManager::connectNodeToView(facebook::react::Tag nodeTag, facebook::react::Tag viewTag) {
     auto &node = dynamic_cast<PropsAnimatedNode &>(getNodeByTag(nodeTag));
     node.connectToView(viewTag);
-    m_nodeTagsToUpdate.insert(nodeTag);
+    setNeedsUpdate(nodeTag);
 }
 
 void AnimatedNodesManager::disconnectNodeFromView(facebook::react::Tag nodeTag, facebook::react::Tag viewTag) {
@@ -101,18 +109,27 @@ void AnimatedNodesManager::addAnimatedEventToView(react::Tag viewTag, const std:
     LOG(INFO) << "addAnimatedEventToView " << viewTag << " " << eventName << " " << eventMapping;
     auto nodeTag = eventMapping["animatedValueTag"].asInt();
     auto dynamicNativeEventPath = eventMapping["nativeEventPath"];
-    std::vector<std::string> nativeEventPath;
+    EventAnimationDriver::EventPath nativeEventPath;
     for (auto &key : dynamicNativeEventPath) {
-        nativeEventPath.push_back(key.asString());
+        nativeEventPath.push_back(PropertyKey::intern(key.asString()));
     }
-    m_eventDrivers.push_back(std::make_unique<EventAnimationDriver>(eventName, viewTag, std::move(nativeEventPath), nodeTag, *this));
+    m_eventDriversByKey[{viewTag, eventName}].push_back(
+        std::make_unique<EventAnimationDriver>(eventName, viewTag, std::move(nativeEventPath), nodeTag, *this));
 }
 
 void AnimatedNodesManager::removeAnimatedEventFromView(facebook::react::Tag viewTag, std::string const &eventName, facebook::react::Tag animatedValueTag) {
     LOG(INFO) << "removeAnimatedEventFromView " << viewTag << " " << eventName << " " << animatedValueTag;
-    m_eventDrivers.erase(std::remove_if(m_eventDrivers.begin(), m_eventDrivers.end(), [&](auto &driver) {
-        return driver->getViewTag() == viewTag && driver->getEventName() == eventName && driver->getNodeTag() == animatedValueTag;
-    }));
+    auto it = m_eventDriversByKey.find({viewTag, eventName});
+    if (it == m_eventDriversByKey.end()) {
+        return;
+    }
+    auto &drivers = it->second;
+    drivers.erase(std::remove_if(drivers.begin(), drivers.end(), [&](auto &driver) {
+        return driver->getNodeTag() == animatedValueTag;
+    }), drivers.end());
+    if (drivers.empty()) {
+        m_eventDriversByKey.erase(it);
+    }
 }
 
 void AnimatedNodesManager::startListeningToAnimatedNodeValue(facebook::react::Tag tag, ValueAnimatedNode::AnimatedNodeValueListener &&listener) {
@@ -125,12 +142,23 @@ void AnimatedNodesManager::stopListeningToAnimatedNodeValue(facebook::react::Tag
     node.removeValueListener();
 }
 
-void AnimatedNodesManager::handleEvent(facebook::react::Tag targetTag, std::string const &eventName, folly::dynamic const &eventValue) {
+void AnimatedNodesManager::handleEvent(
+    facebook::react::Tag targetTag,
+    std::string const &eventName,
+    std::vector<EventValue> const &eventValues) {
+    auto it = m_eventDriversByKey.find({targetTag, eventName});
+    if (it == m_eventDriversByKey.end()) {
+        return;
+    }
+
     bool someDriverNeedsUpdate = false;
-    for (auto &driver : m_eventDrivers) {
-        if (driver->getViewTag() == targetTag && driver->getEventName() == eventName) {
-            someDriverNeedsUpdate = true;
-            driver->updateWithEvent(eventValue);
+    for (auto &driver : it->second) {
+        for (auto const &eventValue : eventValues) {
+            if (driver->getNodeTag() == eventValue.nodeTag && driver->getEventPath() == eventValue.eventPath) {
+                someDriverNeedsUpdate = true;
+                driver->updateWithValue(eventValue.value);
+                break;
+            }
         }
     }
 
@@ -143,14 +171,14 @@ void AnimatedNodesManager::handleEvent(facebook::react::Tag targetTag, std::stri
 void AnimatedNodesManager::setValue(facebook::react::Tag tag, double value) {
     auto &node = getValueNodeByTag(tag);
     stopAnimationsForNode(tag);
-    m_nodeTagsToUpdate.insert(tag);
+    setNeedsUpdate(tag);
     node.setValue(value);
     maybeStartAnimations();
 }
 
 void AnimatedNodesManager::setOffset(facebook::react::Tag tag, double offset) {
     auto &node = getValueNodeByTag(tag);
-    m_nodeTagsToUpdate.insert(tag);
+    setNeedsUpdate(tag);
     node.setOffset(offset);
     maybeStartAnimations();
 }
@@ -190,6 +218,7 @@ void AnimatedNodesManager::startAnimatingNode(facebook::react::Tag animationId,
         throw std::runtime_error("Unsupported animation type: " + type);
     }
 
+    driver->getTelemetry().type = type;
     m_animationById.insert({animationId, std::move(driver)});
     maybeStartAnimations();
 }
@@ -197,20 +226,34 @@ void AnimatedNodesManager::startAnimatingNode(facebook::react::Tag animationId,
 void AnimatedNodesManager::stopAnimation(facebook::react::Tag animationId) {
     if (auto it = m_animationById.find(animationId); it != m_animationById.end()) {
         if (it->second->getId() == animationId) {
+            recordEndedAnimation(*it->second, false);
             it->second->endCallback_(false);
             m_animationById.erase(animationId);
         }
     }
 }
 
-void AnimatedNodesManager::runUpdates(uint64_t frameTimeNanos) {
+void AnimatedNodesManager::runUpdates(uint64_t frameTimeNanos, int64_t targetFrameIntervalInNs) {
+    auto evaluationStartTime = std::chrono::steady_clock::now();
+    auto isVsyncFrame = targetFrameIntervalInNs > 0;
+    [[maybe_unused]] uint64_t droppedFramesCount = 0;
+
     // we don't want to enter this while updating nodes (which can happen if a tracking node starts a new animation)
     m_isRunningAnimations = true;
     std::vector<facebook::react::Tag> finishedAnimations;
+    std::vector<facebook::react::Tag> recordedAnimations;
 
     for (auto &[animationId, driver] : m_animationById) {
+        if (isVsyncFrame) {
+            auto &telemetry = driver->getTelemetry();
+            auto previousDroppedFramesCount = telemetry.droppedFramesCount;
+            // NOTE: animations that benefit from fewer frames (see getMinUsefulFrameIntervalInNs) don't drop the rest
+            driver->recordFrame(frameTimeNanos, std::max(targetFrameIntervalInNs, driver->getMinUsefulFrameIntervalInNs()));
+            droppedFramesCount = std::max(droppedFramesCount, telemetry.droppedFramesCount - previousDroppedFramesCount);
+            recordedAnimations.push_back(animationId);
+        }
         driver->runAnimationStep(frameTimeNanos);
-        m_nodeTagsToUpdate.insert(driver->getAnimatedValueTag());
+        setNeedsUpdate(driver->getAnimatedValueTag());
         if (driver->hasFinished()) {
             finishedAnimations.push_back(animationId);
         }
@@ -218,8 +261,20 @@ void AnimatedNodesManager::runUpdates(uint64_t frameTimeNanos) {
 
     updateNodes();
 
+    auto evaluationTimeInNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now() - evaluationStartTime)
+                                  .count();
+    // NOTE: updating nodes may have stopped some of the animations
+    for (auto animationId : recordedAnimations) {
+        if (auto it = m_animationById.find(animationId); it != m_animationById.end()) {
+            it->second->recordEvaluationTime(evaluationTimeInNs);
+        }
+    }
+
     for (auto animationId : finishedAnimations) {
-        m_animationById.at(animationId)->endCallback_(true);
+        auto &driver = m_animationById.at(animationId);
+        recordEndedAnimation(*driver, true);
+        driver->endCallback_(true);
         m_animationById.erase(animationId);
     }
 
@@ -229,85 +284,198 @@ void AnimatedNodesManager::runUpdates(uint64_t frameTimeNanos) {
         m_isRunningAnimations = true;
         m_scheduleUpdateFn();
     }
+#ifdef RNOH_ANIMATED_TRACE_COUNTERS
+    // NOTE: opt-in (add -DRNOH_ANIMATED_TRACE_COUNTERS to the rnoh compile options), as it's called on every frame
+    if (isVsyncFrame) {
+        OH_HiTrace_CountTrace("RNOH::Animated::droppedFrames", droppedFramesCount);
+    }
+#endif
 }
 
-void AnimatedNodesManager::setNeedsUpdate(facebook::react::Tag nodeTag) {
-    m_nodeTagsToUpdate.insert(nodeTag);
+int64_t AnimatedNodesManager::getMinUsefulFrameIntervalInNs() const {
+    if (m_animationById.empty()) {
+        return 0;
+    }
+    auto result = std::numeric_limits<int64_t>::max();
+    for (auto const &[animationId, driver] : m_animationById) {
+        result = std::min(result, driver->getMinUsefulFrameIntervalInNs());
+    }
+    return result;
 }
 
-void AnimatedNodesManager::updateNodes() {
-    std::vector<facebook::react::Tag> nodeTags(m_nodeTagsToUpdate.begin(), m_nodeTagsToUpdate.end());
-    m_nodeTagsToUpdate.clear();
-
-    uint64_t activeNodesCount = 0;
-    uint64_t updatedNodesCount = 0;
+std::vector<AnimationTelemetry> AnimatedNodesManager::getAnimationTelemetry() const {
+    std::vector<AnimationTelemetry> result;
+    result.reserve(m_animationById.size() + m_endedAnimationsTelemetry.size());
+    for (auto const &[animationId, driver] : m_animationById) {
+        result.push_back(driver->getTelemetry());
+    }
+    result.insert(result.end(), m_endedAnimationsTelemetry.rbegin(), m_endedAnimationsTelemetry.rend());
+    return result;
+}
 
-    std::queue<react::Tag> nodeTagsQueue;
-    for (auto node : nodeTags) {
-        nodeTagsQueue.push(node);
+void AnimatedNodesManager::recordEndedAnimation(AnimationDriver &driver, bool hasCompleted) {
+    auto &telemetry = driver.getTelemetry();
+    telemetry.isRunning = false;
+    telemetry.hasCompleted = hasCompleted;
+    if (telemetry.droppedFramesCount > 0 || telemetry.clampedFramesCount > 0) {
+        DLOG(INFO) << "Animation " << telemetry.animationId << " (" << telemetry.type << ") dropped "
+                   << telemetry.droppedFramesCount << " of " << telemetry.framesCount + telemetry.droppedFramesCount
+                   << " frames, worst frame delta: " << telemetry.maxFrameDeltaInNs / 1e6 << " ms";
     }
-    std::unordered_set<react::Tag> visitedNodeTags;
-    std::unordered_map<react::Tag, uint64_t> incomingEdgesCount;
+    m_endedAnimationsTelemetry.push_back(telemetry);
+    if (m_endedAnimationsTelemetry.size() > MAX_ENDED_ANIMATIONS_TELEMETRY_COUNT) {
+        m_endedAnimationsTelemetry.pop_front();
+    }
+}
 
-    // first, we traverse the nodes graph to find all active nodes
-    // and count incoming edges for each node
-    while (!nodeTagsQueue.empty()) {
-        auto tag = nodeTagsQueue.front();
-        nodeTagsQueue.pop();
+void AnimatedNodesManager::setNeedsUpdate(facebook::react::Tag nodeTag) {
+    if (!m_isScheduleValid) {
+        m_dirtyNodeTagsToSchedule.push_back(nodeTag);
+        return;
+    }
+    if (auto it = m_scheduledNodeIdxByTag.find(nodeTag); it != m_scheduledNodeIdxByTag.end()) {
+        m_isScheduledNodeDirty[it->second] = 1;
+        m_firstDirtyScheduledNodeIdx = std::min<size_t>(m_firstDirtyScheduledNodeIdx, it->second);
+    }
+}
 
-        if (visitedNodeTags.find(tag) != visitedNodeTags.end()) {
-            continue;
+void AnimatedNodesManager::invalidateSchedule() {
+    if (!m_isScheduleValid) {
+        return;
+    }
+    m_isScheduleValid = false;
+    for (size_t i = m_firstDirtyScheduledNodeIdx; i < m_scheduledNodes.size(); i++) {
+        if (m_isScheduledNodeDirty[i]) {
+            m_dirtyNodeTagsToSchedule.push_back(m_scheduledNodes[i]->tag_);
         }
+    }
+}
 
-        visitedNodeTags.insert(tag);
-        activeNodesCount++;
-
-        auto &node = getNodeByTag(tag);
+void AnimatedNodesManager::compileSchedule() {
+    auto nodesCount = m_nodeByTag.size();
+    std::vector<AnimatedNode *> nodes;
+    nodes.reserve(nodesCount);
+    std::unordered_map<react::Tag, uint32_t> nodeIdxByTag;
+    nodeIdxByTag.reserve(nodesCount);
+    for (auto &[tag, node] : m_nodeByTag) {
+        nodeIdxByTag.emplace(tag, nodes.size());
+        nodes.push_back(node.get());
+    }
 
-        for (auto childTag : node.getChildrenTags()) {
-            nodeTagsQueue.push(childTag);
-            incomingEdgesCount[childTag]++;
+    // Kahn's algorithm; children of dropped nodes are skipped
+    std::vector<uint32_t> incomingEdgesCount(nodesCount, 0);
+    for (auto node : nodes) {
+        for (auto childTag : node->getChildrenTags()) {
+            if (auto it = nodeIdxByTag.find(childTag); it != nodeIdxByTag.end()) {
+                incomingEdgesCount[it->second]++;
+            }
+        }
+    }
+    std::vector<uint32_t> sortedNodeIdxs;
+    sortedNodeIdxs.reserve(nodesCount);
+    for (uint32_t i = 0; i < nodesCount; i++) {
+        if (incomingEdgesCount[i] == 0) {
+            sortedNodeIdxs.push_back(i);
+        }
+    }
+    for (size_t i = 0; i < sortedNodeIdxs.size(); i++) {
+        for (auto childTag : nodes[sortedNodeIdxs[i]]->getChildrenTags()) {
+            if (auto it = nodeIdxByTag.find(childTag); it != nodeIdxByTag.end() && --incomingEdgesCount[it->second] == 0) {
+                sortedNodeIdxs.push_back(it->second);
+            }
         }
     }
+    if (sortedNodeIdxs.size() != nodesCount) {
+        throw std::runtime_error(
+            "There were " + std::to_string(nodesCount) + " nodes, but only " + std::to_string(sortedNodeIdxs.size()) + " could be sorted; the graph contains a cycle");
+    }
 
-    // second, we visit all active nodeTags with no incoming edges
-    // (meaning they're either the root nodeTags, or their parents were already visited)
-    // and perform the updates
-    for (auto node : nodeTags) {
-        if (incomingEdgesCount[node] == 0) {
-            nodeTagsQueue.push(node);
+    m_scheduledNodeIdxByTag.clear();
+    m_scheduledNodes.clear();
+    m_scheduledOps.clear();
+    for (auto nodeIdx : sortedNodeIdxs) {
+        auto node = nodes[nodeIdx];
+        m_scheduledNodeIdxByTag.emplace(node->tag_, m_scheduledNodes.size());
+        m_scheduledNodes.push_back(node);
+        if (dynamic_cast<PropsAnimatedNode *>(node) != nullptr) {
+            m_scheduledOps.push_back(NodeUpdateOp::UPDATE_PROPS);
+        } else if (dynamic_cast<ValueAnimatedNode *>(node) != nullptr) {
+            m_scheduledOps.push_back(NodeUpdateOp::UPDATE_VALUE);
+        } else {
+            m_scheduledOps.push_back(NodeUpdateOp::UPDATE);
         }
     }
-    while (!nodeTagsQueue.empty()) {
-        auto tag = nodeTagsQueue.front();
-        nodeTagsQueue.pop();
+    m_scheduledChildIdxsOffsets.clear();
+    m_scheduledChildIdxs.clear();
+    for (auto node : m_scheduledNodes) {
+        m_scheduledChildIdxsOffsets.push_back(m_scheduledChildIdxs.size());
+        for (auto childTag : node->getChildrenTags()) {
+            if (auto it = m_scheduledNodeIdxByTag.find(childTag); it != m_scheduledNodeIdxByTag.end()) {
+                m_scheduledChildIdxs.push_back(it->second);
+            }
+        }
+    }
+    m_scheduledChildIdxsOffsets.push_back(m_scheduledChildIdxs.size());
+
+    m_isScheduledNodeDirty.assign(nodesCount, 0);
+    m_firstDirtyScheduledNodeIdx = nodesCount;
+    m_isScheduleValid = true;
+    for (auto tag : m_dirtyNodeTagsToSchedule) {
+        setNeedsUpdate(tag);
+    }
+    m_dirtyNodeTagsToSchedule.clear();
+}
 
-        auto &node = getNodeByTag(tag);
-        node.update();
+void AnimatedNodesManager::updateNodes() {
+    if (!m_isScheduleValid) {
+        compileSchedule();
+    }
 
-        if (auto propsNode = dynamic_cast<PropsAnimatedNode *>(&node); propsNode != nullptr) {
-            propsNode->updateView();
+    // NOTE: nodes marked as dirty during the pass are updated in this pass if they come later in the schedule,
+    // and in the next one otherwise
+    auto firstDirtyNodeIdx = m_firstDirtyScheduledNodeIdx;
+    auto nodesCount = m_scheduledNodes.size();
+    m_firstDirtyScheduledNodeIdx = nodesCount;
+    for (auto i = firstDirtyNodeIdx; i < nodesCount; i++) {
+        if (!m_isScheduledNodeDirty[i]) {
+            continue;
         }
-
-        if (auto valueNode = dynamic_cast<ValueAnimatedNode *>(&node); valueNode != nullptr) {
-            valueNode->onValueUpdate();
+        m_isScheduledNodeDirty[i] = 0;
+
+        auto node = m_scheduledNodes[i];
+        node->update();
+        switch (m_scheduledOps[i]) {
+        case NodeUpdateOp::UPDATE_PROPS:
+            static_cast<PropsAnimatedNode *>(node)->updateView();
+            break;
+        case NodeUpdateOp::UPDATE_VALUE:
+            static_cast<ValueAnimatedNode *>(node)->onValueUpdate();
+            break;
+        case NodeUpdateOp::UPDATE:
+            break;
         }
 
-        updatedNodesCount++;
-
-        for (auto childTag : node.getChildrenTags()) {
-            incomingEdgesCount[childTag]--;
-            if (incomingEdgesCount[childTag] == 0) {
-                nodeTagsQueue.push(childTag);
-            }
+        for (auto j = m_scheduledChildIdxsOffsets[i]; j < m_scheduledChildIdxsOffsets[i + 1]; j++) {
+            m_isScheduledNodeDirty[m_scheduledChildIdxs[j]] = 1;
         }
     }
 
-    if (activeNodesCount != updatedNodesCount) {
-        // if not all active nodes were updated, it means there's a cycle in the graph
-        throw std::runtime_error(
-            "There were " + std::to_string(activeNodesCount) + " active nodes, but only " + std::to_string(updatedNodesCount) + " were updated");
+    flushProps();
+}
+
+void AnimatedNodesManager::flushProps() {
+    if (m_propsBatch.isEmpty()) {
+        return;
     }
+    m_flushPropsFn(m_propsBatch.takeBuffer(), m_propNames.takeNewNames());
+}
+
+AnimatedPropId AnimatedNodesManager::internPropName(std::string const &name) {
+    return m_propNames.intern(name);
+}
+
+AnimatedPropsBatch &AnimatedNodesManager::getPropsBatch() {
+    return m_propsBatch;
 }
 
 void AnimatedNodesManager::stopAnimationsForNode(facebook::react::Tag tag) {
@@ -324,7 +492,8 @@ void AnimatedNodesManager::stopAnimationsForNode(facebook::react::Tag tag) {
 
 void AnimatedNodesManager::maybeStartAnimations() {
     if (!m_isRunningAnimations) {
-        auto now = std::chrono::high_resolution_clock::now();
+        // NOTE: steady_clock is the clock vsync timestamps come from
+        auto now = std::chrono::steady_clock::now();
         auto frameTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch());
         runUpdates(frameTime.count());
     }
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <cstdint>
+#include <deque>
 #include <unordered_map>
+#include <vector>
 
 #include <jsi/jsi.h>
 #include <folly/dynamic.h>
 #include <react/renderer/core/ReactPrimitives.h>
 
+#include "AnimatedPropsBatch.h"
+#include "RNOH/AnimationTelemetry.h"
+#include "RNOH/PropertyKey.h"
 #include "Nodes/AnimatedNode.h"
 #include "Drivers/AnimationDriver.h"
 #include "Drivers/EventAnimationDriver.h"
@@ -19,9 +25,14 @@ class EventAnimationDriver;
 
 class AnimatedNodesManager {
 public:
+    /**
+     * Receives props of all views updated in a single pass, see AnimatedPropsBatch.
+     */
+    using FlushPropsFn = std::function<void(std::shared_ptr<AnimatedPropsBatch::Buffer> buffer, std::vector<std::string> newPropNames)>;
+
     AnimatedNodesManager(
         std::function<void()> &&scheduleUpdateFn,
-        std::function<void(facebook::react::Tag, folly::dynamic)> &&setNativePropsFn
+        FlushPropsFn &&flushPropsFn
     );
 
     void createNode(facebook::react::Tag tag, folly::dynamic const &config);
@@ -53,27 +64,88 @@ public:
         std::function<void(bool)> &&endCallback);
     void stopAnimation(facebook::react::Tag animationId);
 
-    void runUpdates(uint64_t frameTimeNanos);
+    /**
+     * `targetFrameIntervalInNs` is the display's frame interval on vsync frames, and 0 on updates made outside of them,
+     * which aren't recorded in the telemetry.
+     */
+    void runUpdates(uint64_t frameTimeNanos, int64_t targetFrameIntervalInNs = 0);
+
+    /**
+     * The shortest frame interval any running animation benefits from, or 0 if some animation benefits from every vsync.
+     */
+    int64_t getMinUsefulFrameIntervalInNs() const;
+
+    /**
+     * Telemetry of running animations, followed by the most recently ended ones.
+     */
+    std::vector<AnimationTelemetry> getAnimationTelemetry() const;
 
     void setNeedsUpdate(facebook::react::Tag nodeTag);
 
-    void handleEvent(facebook::react::Tag targetTag, std::string const &eventName, folly::dynamic const &eventValue);
+    /**
+     * A value read from the event payload at `eventPath` for the driver of node `nodeTag`.
+     */
+    struct EventValue {
+        facebook::react::Tag nodeTag;
+        std::vector<PropertyKey> eventPath;
+        double value;
+    };
+
+    /**
+     * `eventValues` contains values read from the event payload for drivers bound to the event. A driver is updated
+     * with the value read for its node at its event path.
+     */
+    void handleEvent(
+        facebook::react::Tag targetTag,
+        std::string const &eventName,
+        std::vector<EventValue> const &eventValues);
 
     AnimatedNode &getNodeByTag(facebook::react::Tag tag);
     ValueAnimatedNode &getValueNodeByTag(facebook::react::Tag tag);
 
-    std::function<void(facebook::react::Tag, folly::dynamic)> m_setNativePropsFn;
+    AnimatedPropId internPropName(std::string const &name);
+    AnimatedPropsBatch &getPropsBatch();
+
 private:
+    enum class NodeUpdateOp : uint8_t {
+        UPDATE,
+        UPDATE_VALUE,
+        UPDATE_PROPS,
+    };
+
     void updateNodes();
+    void flushProps();
+    void invalidateSchedule();
+    void compileSchedule();
     void stopAnimationsForNode(facebook::react::Tag tag);
     void maybeStartAnimations();
+    void recordEndedAnimation(AnimationDriver &driver, bool hasCompleted);
 
     std::function<void()> m_scheduleUpdateFn;
+    FlushPropsFn m_flushPropsFn;
+    AnimatedPropNames m_propNames;
+    AnimatedPropsBatch m_propsBatch;
     std::unordered_map<facebook::react::Tag, std::unique_ptr<AnimatedNode>> m_nodeByTag;
     std::unordered_map<facebook::react::Tag, std::unique_ptr<AnimationDriver>> m_animationById;
-    std::vector<std::unique_ptr<EventAnimationDriver>> m_eventDrivers;
-    std::unordered_set<facebook::react::Tag> m_nodeTagsToUpdate;
+    std::unordered_map<AnimatedEventKey, std::vector<std::unique_ptr<EventAnimationDriver>>, AnimatedEventKeyHash> m_eventDriversByKey;
+
+    /**
+     * Topologically sorted nodes graph, compiled lazily after nodes are created, dropped, connected or disconnected.
+     * Children of the node at index i are at m_scheduledChildIdxs[m_scheduledChildIdxsOffsets[i] ..
+     * m_scheduledChildIdxsOffsets[i + 1]), and always come after it, so updating dirty nodes is a single pass.
+     */
+    bool m_isScheduleValid = false;
+    std::vector<AnimatedNode *> m_scheduledNodes;
+    std::vector<NodeUpdateOp> m_scheduledOps;
+    std::vector<uint32_t> m_scheduledChildIdxsOffsets;
+    std::vector<uint32_t> m_scheduledChildIdxs;
+    std::vector<uint8_t> m_isScheduledNodeDirty;
+    size_t m_firstDirtyScheduledNodeIdx = 0;
+    std::unordered_map<facebook::react::Tag, uint32_t> m_scheduledNodeIdxByTag;
+    // NOTE: nodes marked as dirty while the schedule is invalid
+    std::vector<facebook::react::Tag> m_dirtyNodeTagsToSchedule;
     bool m_isRunningAnimations = false;
+    std::deque<AnimationTelemetry> m_endedAnimationsTelemetry;
 };
 
 }
\ No newline at end of file
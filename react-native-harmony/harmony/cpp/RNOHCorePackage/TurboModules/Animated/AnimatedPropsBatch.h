@@ -0,0 +1,224 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <react/renderer/core/ReactPrimitives.h>
+#include <react/renderer/graphics/Float.h>
+
+namespace rnoh {
+
+using AnimatedPropId = uint16_t;
+
+/**
+ * Maps animated prop names to ids. Names are interned when props and style nodes are created; names interned since the
+ * last batch are sent along with the next one, so ArkTS can resolve ids without a separate call.
+ */
+class AnimatedPropNames {
+  public:
+    AnimatedPropId intern(std::string const &name) {
+        if (auto it = m_idByName.find(name); it != m_idByName.end()) {
+            return it->second;
+        }
+        if (m_idByName.size() > std::numeric_limits<AnimatedPropId>::max()) {
+            throw std::runtime_error("Too many animated prop names, can't intern " + name);
+        }
+        auto id = static_cast<AnimatedPropId>(m_idByName.size());
+        m_idByName.emplace(name, id);
+        m_newNames.push_back(name);
+        return id;
+    }
+
+    std::vector<std::string> takeNewNames() {
+        return std::move(m_newNames);
+    }
+
+  private:
+    std::unordered_map<std::string, AnimatedPropId> m_idByName;
+    std::vector<std::string> m_newNames;
+};
+
+/**
+ * Animated props of all views updated in a single pass over the nodes graph, delivered to ArkTS in one call.
+ * Must be kept in sync with NativeAnimatedTurboModule.ts.
+ *
+ * Layout (little-endian), a sequence of records:
+ *   i32 viewTag, u16 propId, u8 valueType, u8 reserved, followed by
+ *   f64 for NUMBER, 16 * f64 (column-major transform matrix) for MATRIX, or u32 byteLength + UTF-8 bytes for STRING
+ */
+class AnimatedPropsBatch {
+  public:
+    using Buffer = std::vector<uint8_t>;
+
+    enum ValueType : uint8_t {
+        NUMBER = 0,
+        MATRIX = 1,
+        STRING = 2,
+    };
+
+    void addNumber(facebook::react::Tag viewTag, AnimatedPropId propId, double value) {
+        writeRecordHeader(viewTag, propId, ValueType::NUMBER);
+        write(value);
+    }
+
+    void addMatrix(facebook::react::Tag viewTag, AnimatedPropId propId, std::array<facebook::react::Float, 16> const &matrix) {
+        writeRecordHeader(viewTag, propId, ValueType::MATRIX);
+        for (auto value : matrix) {
+            write(static_cast<double>(value));
+        }
+    }
+
+    void addString(facebook::react::Tag viewTag, AnimatedPropId propId, std::string const &value) {
+        writeRecordHeader(viewTag, propId, ValueType::STRING);
+        write(static_cast<uint32_t>(value.size()));
+        m_buffer->insert(m_buffer->end(), value.begin(), value.end());
+    }
+
+    /**
+     * Adds the value of `ValueAnimatedNode`, preferring its string value if it has one.
+     */
+    template <typename TValueNode>
+    void addValue(facebook::react::Tag viewTag, AnimatedPropId propId, TValueNode &valueNode) {
+        if (auto stringValue = valueNode.getStringValue(); stringValue.has_value()) {
+            addString(viewTag, propId, stringValue.value());
+        } else {
+            addNumber(viewTag, propId, valueNode.getValue());
+        }
+    }
+
+    bool isEmpty() const {
+        return m_buffer->empty();
+    }
+
+    /**
+     * Returns the encoded records and starts a new batch.
+     */
+    std::shared_ptr<Buffer> takeBuffer() {
+        return std::exchange(m_buffer, std::make_shared<Buffer>());
+    }
+
+    /**
+     * Removes records overridden by a later record for the same view and prop, keeping the order of the rest.
+     */
+    static void removeOverriddenRecords(Buffer &buffer) {
+        struct Record {
+            size_t offset;
+            size_t size;
+            uint64_t key;
+        };
+        std::vector<Record> records;
+        std::unordered_map<uint64_t, size_t> lastRecordIdxByKey;
+        for (size_t offset = 0; offset < buffer.size();) {
+            int32_t viewTag;
+            AnimatedPropId propId;
+            std::memcpy(&viewTag, buffer.data() + offset, sizeof(viewTag));
+            std::memcpy(&propId, buffer.data() + offset + sizeof(viewTag), sizeof(propId));
+            auto valueType = static_cast<ValueType>(buffer[offset + RECORD_HEADER_SIZE - 2]);
+            size_t size = RECORD_HEADER_SIZE;
+            if (valueType == ValueType::NUMBER) {
+                size += sizeof(double);
+            } else if (valueType == ValueType::MATRIX) {
+                size += 16 * sizeof(double);
+            } else {
+                uint32_t byteLength;
+                std::memcpy(&byteLength, buffer.data() + offset + RECORD_HEADER_SIZE, sizeof(byteLength));
+                size += sizeof(byteLength) + byteLength;
+            }
+            auto key = (static_cast<uint64_t>(static_cast<uint32_t>(viewTag)) << 16) | propId;
+            lastRecordIdxByKey[key] = records.size();
+            records.push_back({offset, size, key});
+            offset += size;
+        }
+        if (lastRecordIdxByKey.size() == records.size()) {
+            return;
+        }
+        Buffer result;
+        result.reserve(buffer.size());
+        for (size_t i = 0; i < records.size(); i++) {
+            if (lastRecordIdxByKey[records[i].key] == i) {
+                auto begin = buffer.begin() + records[i].offset;
+                result.insert(result.end(), begin, begin + records[i].size);
+            }
+        }
+        buffer = std::move(result);
+    }
+
+  private:
+    static constexpr size_t RECORD_HEADER_SIZE = sizeof(int32_t) + sizeof(AnimatedPropId) + 2 * sizeof(uint8_t);
+
+    void writeRecordHeader(facebook::react::Tag viewTag, AnimatedPropId propId, ValueType valueType) {
+        write(static_cast<int32_t>(viewTag));
+        write(propId);
+        write(static_cast<uint8_t>(valueType));
+        write(static_cast<uint8_t>(0));
+    }
+
+    template <typename T>
+    void write(T value) {
+        auto offset = m_buffer->size();
+        m_buffer->resize(offset + sizeof(T));
+        std::memcpy(m_buffer->data() + offset, &value, sizeof(T));
+    }
+
+    std::shared_ptr<Buffer> m_buffer = std::make_shared<Buffer>();
+};
+
+struct AnimatedPropsSnapshot {
+    std::shared_ptr<AnimatedPropsBatch::Buffer> buffer;
+    std::vector<std::string> newPropNames;
+};
+
+/**
+ * Hands over props snapshots from the animation thread (single producer) to the UI thread (single consumer) without
+ * locking. There is at most one pending snapshot; if the UI thread hasn't taken it before the next one is published,
+ * the two are merged, so props of views updated only in the older snapshot aren't lost. Records overridden by the newer
+ * snapshot are dropped while merging, so the pending snapshot doesn't grow while the UI thread is stalled.
+ */
+class AnimatedPropsSnapshotExchange {
+  public:
+    ~AnimatedPropsSnapshotExchange() {
+        delete m_pendingSnapshot.exchange(nullptr);
+    }
+
+    /**
+     * Returns true if the consumer needs to be scheduled to `take` the snapshot.
+     */
+    bool publish(std::unique_ptr<AnimatedPropsSnapshot> snapshot) {
+        std::unique_ptr<AnimatedPropsSnapshot> pendingSnapshot(m_pendingSnapshot.exchange(nullptr));
+        if (pendingSnapshot != nullptr) {
+            auto &buffer = *pendingSnapshot->buffer;
+            buffer.insert(buffer.end(), snapshot->buffer->begin(), snapshot->buffer->end());
+            AnimatedPropsBatch::removeOverriddenRecords(buffer);
+            pendingSnapshot->newPropNames.insert(
+                pendingSnapshot->newPropNames.end(),
+                std::make_move_iterator(snapshot->newPropNames.begin()),
+                std::make_move_iterator(snapshot->newPropNames.end()));
+            snapshot = std::move(pendingSnapshot);
+        }
+        m_pendingSnapshot.store(snapshot.release());
+        return !m_isConsumerScheduled.exchange(true);
+    }
+
+    /**
+     * Returns nullptr if the snapshot was already taken by a previously scheduled consumer.
+     */
+    std::unique_ptr<AnimatedPropsSnapshot> take() {
+        // NOTE: cleared before taking, so a snapshot published after this point schedules the consumer again
+        m_isConsumerScheduled.store(false);
+        return std::unique_ptr<AnimatedPropsSnapshot>(m_pendingSnapshot.exchange(nullptr));
+    }
+
+  private:
+    std::atomic<AnimatedPropsSnapshot *> m_pendingSnapshot{nullptr};
+    std::atomic_bool m_isConsumerScheduled{false};
+};
+
+} // namespace rnoh
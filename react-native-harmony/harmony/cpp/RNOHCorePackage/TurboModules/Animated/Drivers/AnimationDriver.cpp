@@ -1,5 +1,8 @@
 #include "AnimationDriver.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace facebook;
 
 namespace rnoh {
@@ -8,7 +11,10 @@ AnimationDriver::AnimationDriver(react::Tag animationId, react::Tag animatedNode
     : m_animationId(animationId),
       m_animatedNodeTag(animatedNode),
       m_nodesManager(nodesManager),
-      endCallback_(std::move(endCallback)) {}
+      endCallback_(std::move(endCallback)) {
+    m_telemetry.animationId = animationId;
+    m_telemetry.nodeTag = animatedNode;
+}
 
 void AnimationDriver::resetConfig(folly::dynamic const &config) {
     throw std::runtime_error("AnimationDriver::resetConfig() is not implemented");
@@ -30,4 +36,27 @@ bool AnimationDriver::hasFinished() const {
     return m_hasFinished;
 }
 
+void AnimationDriver::recordFrame(int64_t frameTimeNanos, int64_t expectedFrameIntervalInNs) {
+    m_telemetry.framesCount++;
+    if (m_lastRecordedFrameTimeNanos >= 0 && frameTimeNanos > m_lastRecordedFrameTimeNanos) {
+        auto frameDelta = frameTimeNanos - m_lastRecordedFrameTimeNanos;
+        m_telemetry.maxFrameDeltaInNs = std::max(m_telemetry.maxFrameDeltaInNs, frameDelta);
+        if (expectedFrameIntervalInNs > 0) {
+            // NOTE: rounded, so vsync jitter isn't counted as a drop
+            auto elapsedFramesCount = std::llround(static_cast<double>(frameDelta) / expectedFrameIntervalInNs);
+            m_telemetry.droppedFramesCount += std::max<long long>(elapsedFramesCount - 1, 0);
+        }
+    }
+    m_lastRecordedFrameTimeNanos = frameTimeNanos;
+}
+
+void AnimationDriver::recordEvaluationTime(int64_t evaluationTimeInNs) {
+    m_telemetry.totalEvaluationTimeInNs += evaluationTimeInNs;
+    m_telemetry.maxEvaluationTimeInNs = std::max(m_telemetry.maxEvaluationTimeInNs, evaluationTimeInNs);
+}
+
+AnimationTelemetry &AnimationDriver::getTelemetry() {
+    return m_telemetry;
+}
+
 } // namespace rnoh
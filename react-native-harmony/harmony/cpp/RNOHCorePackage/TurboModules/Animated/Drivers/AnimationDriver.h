@@ -3,6 +3,7 @@
 #include <folly/dynamic.h>
 
 #include "RNOHCorePackage/TurboModules/Animated/AnimatedNodesManager.h"
+#include "RNOH/AnimationTelemetry.h"
 #include "RNOHCorePackage/TurboModules/Animated/Nodes/ValueAnimatedNode.h"
 
 namespace rnoh {
@@ -19,11 +20,26 @@ public:
     virtual void runAnimationStep(uint64_t frameTimeNanos) = 0;
     virtual void resetConfig(folly::dynamic const &config);
 
+    /**
+     * The shortest frame interval the animation benefits from, or 0 if it benefits from every vsync.
+     */
+    virtual int64_t getMinUsefulFrameIntervalInNs() const {
+        return 0;
+    }
+
     facebook::react::Tag getId() const;
     ValueAnimatedNode &getAnimatedValue();
     facebook::react::Tag getAnimatedValueTag() const;
     bool hasFinished() const;
 
+    /**
+     * Called before `runAnimationStep` on vsync frames. `expectedFrameIntervalInNs` is the interval the animation
+     * should be updated at; frames missed on top of it are counted as dropped.
+     */
+    void recordFrame(int64_t frameTimeNanos, int64_t expectedFrameIntervalInNs);
+    void recordEvaluationTime(int64_t evaluationTimeInNs);
+    AnimationTelemetry &getTelemetry();
+
     AnimationEndCallback endCallback_;
 
 protected:
@@ -31,6 +47,10 @@ protected:
     facebook::react::Tag m_animatedNodeTag;
     AnimatedNodesManager &m_nodesManager;
     bool m_hasFinished = false;
+    AnimationTelemetry m_telemetry;
+
+private:
+    int64_t m_lastRecordedFrameTimeNanos = -1;
 };
 
 } // namespace rnoh
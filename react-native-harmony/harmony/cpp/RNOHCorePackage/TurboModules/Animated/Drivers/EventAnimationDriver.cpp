@@ -14,16 +14,10 @@ EventAnimationDriver::EventAnimationDriver(
       m_nodeTag(nodeTag),
       m_nodesManager(nodesManager) {}
 
-void EventAnimationDriver::updateWithEvent(folly::dynamic const &event) {
-    auto currentEvent = &event;
-    for (auto &key : m_eventPath) {
-        currentEvent = &(*currentEvent)[key];
-    }
-
+void EventAnimationDriver::updateWithValue(double value) {
     auto &valueNode = getValueNode();
-    valueNode.m_value = currentEvent->asDouble();
+    valueNode.m_value = value;
     m_nodesManager.setNeedsUpdate(m_nodeTag);
-    return;
 }
 
 ValueAnimatedNode &EventAnimationDriver::getValueNode() const {
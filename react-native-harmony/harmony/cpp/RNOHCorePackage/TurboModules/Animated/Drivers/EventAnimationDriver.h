@@ -1,5 +1,6 @@
 #pragma once
 
+#include "RNOH/PropertyKey.h"
 #include "RNOHCorePackage/TurboModules/Animated/AnimatedNodesManager.h"
 #include "RNOHCorePackage/TurboModules/Animated/Nodes/ValueAnimatedNode.h"
 
@@ -8,15 +9,33 @@ class AnimatedNodesManager;
 namespace rnoh
 {
 
+struct AnimatedEventKey {
+    facebook::react::Tag viewTag;
+    std::string eventName;
+
+    bool operator==(AnimatedEventKey const &other) const {
+        return viewTag == other.viewTag && eventName == other.eventName;
+    }
+};
+
+struct AnimatedEventKeyHash {
+    size_t operator()(AnimatedEventKey const &key) const {
+        return std::hash<std::string>()(key.eventName) ^ (std::hash<facebook::react::Tag>()(key.viewTag) << 1);
+    }
+};
+
 class EventAnimationDriver {
 public:
     // a list of property names of the event payload (sub)objects 
     // to traverse to get to the value
-    using EventPath = std::vector<std::string>;
+    using EventPath = std::vector<PropertyKey>;
 
     EventAnimationDriver(std::string const &eventName, facebook::react::Tag viewTag, EventPath &&eventPath, facebook::react::Tag nodeTag, AnimatedNodesManager &nodesManager);
 
-    void updateWithEvent(folly::dynamic const &event);
+    /**
+     * `value` is read from the event payload at `getEventPath()` by the caller.
+     */
+    void updateWithValue(double value);
 
     ValueAnimatedNode &getValueNode() const;
 
@@ -32,6 +51,10 @@ public:
         return m_nodeTag;
     }
 
+    EventPath const &getEventPath() const {
+        return m_eventPath;
+    }
+
 private:
     std::string m_eventName;
     facebook::react::Tag m_viewTag;
@@ -1,11 +1,12 @@
 #include "FrameBasedAnimationDriver.h"
 
+#include <algorithm>
 #include <glog/logging.h>
 
 namespace rnoh {
     
-// 60 FPS is hardcoded in React Native
-uint64_t FRAME_TIME_MILLIS = 1000.0 / 60.0;
+// NOTE: React Native samples the easing function at 60 FPS, regardless of the display's refresh rate
+static constexpr double SAMPLE_INTERVAL_MILLIS = 1000.0 / 60.0;
 
 FrameBasedAnimationDriver::FrameBasedAnimationDriver(
     facebook::react::Tag animationId, 
@@ -29,6 +30,9 @@ void FrameBasedAnimationDriver::resetConfig(folly::dynamic const &config) {
     m_iterations = config.getDefault("iterations", 1).asInt();
     m_currentLoop = 1;
     m_startTimeNanos = -1;
+    m_firstFrameTimeNanos = -1;
+    m_lastFrameTimeNanos = -1;
+    m_framesCount = 0;
     m_hasFinished = m_iterations == 0;
 }
 
@@ -45,24 +49,48 @@ void FrameBasedAnimationDriver::runAnimationStep(uint64_t frameTimeNanos) {
             m_fromValue = animatedValue.m_value;
         }
     }
+    if (m_firstFrameTimeNanos < 0) {
+        m_firstFrameTimeNanos = frameTimeNanos;
+    }
+    m_lastFrameTimeNanos = frameTimeNanos;
+    m_framesCount++;
+
+    // NOTE: the position between samples is kept, so displays faster than 60 Hz get distinct values on every vsync
+    // and skipped frames don't accumulate truncation errors
+    auto timeFromStartMillis = static_cast<double>(static_cast<int64_t>(frameTimeNanos) - m_startTimeNanos) / 1e6;
+    auto samplePosition = std::max(timeFromStartMillis, 0.0) / SAMPLE_INTERVAL_MILLIS;
 
-    auto timeFromStart = frameTimeNanos - m_startTimeNanos;
-    uint64_t timeFromStartMillis = timeFromStart / 1e6;
-    auto frameIndex = static_cast<uint64_t>((timeFromStartMillis) / FRAME_TIME_MILLIS);
-    
     double nextValue;
-    if (frameIndex >= m_frames.size() - 1) {
+    if (m_frames.empty() || samplePosition >= m_frames.size() - 1) {
         nextValue = m_toValue;
         if (m_iterations == -1 || m_currentLoop < m_iterations) {
             m_startTimeNanos = -1;
             m_currentLoop++;
         } else {
             m_hasFinished = true;
+            if (auto frameRate = getAchievedFrameRate(); frameRate.has_value()) {
+                DLOG(INFO) << "Frame-based animation " << m_animationId << " ran at " << frameRate.value() << " FPS";
+            }
         }
     } else {
-        nextValue = m_fromValue + (m_toValue - m_fromValue) * m_frames[frameIndex];
+        auto sampleIdx = static_cast<size_t>(samplePosition);
+        auto sampleFraction = samplePosition - sampleIdx;
+        auto progress = m_frames[sampleIdx] + (m_frames[sampleIdx + 1] - m_frames[sampleIdx]) * sampleFraction;
+        nextValue = m_fromValue + (m_toValue - m_fromValue) * progress;
     }
     animatedValue.setValue(nextValue);
 }
 
+int64_t FrameBasedAnimationDriver::getMinUsefulFrameIntervalInNs() const {
+    // NOTE: interpolating between samples faster than they were taken doesn't make the animation smoother
+    return static_cast<int64_t>(SAMPLE_INTERVAL_MILLIS * 1e6);
+}
+
+std::optional<double> FrameBasedAnimationDriver::getAchievedFrameRate() const {
+    if (m_framesCount < 2 || m_lastFrameTimeNanos <= m_firstFrameTimeNanos) {
+        return std::nullopt;
+    }
+    return (m_framesCount - 1) * 1e9 / (m_lastFrameTimeNanos - m_firstFrameTimeNanos);
+}
+
 } // namespace rnoh
@@ -2,6 +2,7 @@
 
 #include "AnimationDriver.h"
 
+#include <optional>
 #include <folly/dynamic.h>
 
 namespace rnoh {
@@ -18,8 +19,19 @@ public:
     void resetConfig(folly::dynamic const &config) override;
 
     void runAnimationStep(uint64_t frameTimeNanos) override;
+
+    int64_t getMinUsefulFrameIntervalInNs() const override;
+
+    /**
+     * Frames per second the animation was actually updated at, or nullopt before the second frame.
+     */
+    std::optional<double> getAchievedFrameRate() const;
+
 private:
     int64_t m_startTimeNanos;
+    int64_t m_firstFrameTimeNanos = -1;
+    int64_t m_lastFrameTimeNanos = -1;
+    uint64_t m_framesCount = 0;
     std::vector<double> m_frames;
     double m_toValue;
     double m_fromValue;
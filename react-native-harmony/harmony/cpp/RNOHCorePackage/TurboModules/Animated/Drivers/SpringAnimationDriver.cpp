@@ -77,6 +77,7 @@ void SpringAnimationDriver::advance(double deltaTime) {
     double adjustedDeltaTime = deltaTime;
     if (deltaTime > MAX_DELTA_TIME_SEC) {
       adjustedDeltaTime = MAX_DELTA_TIME_SEC;
+      m_telemetry.clampedFramesCount++;
     }
 
     m_timeAccumulator += adjustedDeltaTime;
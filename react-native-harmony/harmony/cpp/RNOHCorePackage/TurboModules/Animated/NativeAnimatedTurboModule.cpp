@@ -1,7 +1,10 @@
 #include "NativeAnimatedTurboModule.h"
 
 #include <jsi/jsi/JSIDynamic.h>
+#include <hitrace/trace.h>
+#include <algorithm>
 #include <chrono>
+#include <optional>
 
 using namespace facebook;
 
@@ -234,25 +237,26 @@ jsi::Value removeAnimatedEventFromView(
     return facebook::jsi::Value::undefined();
 }
 
-static void scheduleUpdate(long long timestamp, void *data) {
-    auto self = static_cast<NativeAnimatedTurboModule *>(data);
-    self->runUpdates();
-}
-
 NativeAnimatedTurboModule::NativeAnimatedTurboModule(const ArkTSTurboModule::Context ctx, const std::string name)
     : rnoh::ArkTSTurboModule(ctx, name),
-      m_vsyncHandle("AnimatedTurboModule"),
       m_animatedNodesManager(
-          [this] {
-              m_ctx.taskExecutor->runTask(TaskThread::MAIN, [this] { m_vsyncHandle.requestFrame(rnoh::scheduleUpdate, this); });
-          },
-          [this](auto tag, auto props) {
-              if (m_ctx.taskExecutor->isOnTaskThread(TaskThread::MAIN)) {
-                this->setNativeProps(tag, props);
-              } else {
-                m_ctx.taskExecutor->runTask(TaskThread::MAIN, [this, tag, props] { this->setNativeProps(tag, props); });
+          [this] { this->requestFrame(); },
+          [this](auto buffer, auto newPropNames) {
+              auto snapshot = std::make_unique<AnimatedPropsSnapshot>(
+                  AnimatedPropsSnapshot{.buffer = std::move(buffer), .newPropNames = std::move(newPropNames)});
+              if (m_propsSnapshotExchange.publish(std::move(snapshot))) {
+                  // NOTE: the module can be destroyed before MAIN runs the task
+                  m_ctx.taskExecutor->runTask(
+                      TaskThread::MAIN,
+                      [weakSelf = weak_from_this()] {
+                          if (auto self = weakSelf.lock()) {
+                              self->applyPropsSnapshot();
+                          }
+                      },
+                      TaskPriority::ANIMATION);
               }
-          }) {
+          }),
+      m_animationTaskRunner(std::make_unique<ThreadTaskRunner>("RNOH_ANIMATED")) {
     methodMap_ = {
         {"startOperationBatch", {0, rnoh::startOperationBatch}},
         {"finishOperationBatch", {0, rnoh::finishOperationBatch}},
@@ -290,45 +294,42 @@ void NativeAnimatedTurboModule::finishOperationBatch() {
 }
 
 void NativeAnimatedTurboModule::createAnimatedNode(react::Tag tag, folly::dynamic const &config) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.createNode(tag, config);
+    runOnAnimationThread([this, tag, config] { m_animatedNodesManager.createNode(tag, config); });
 }
 
 void NativeAnimatedTurboModule::updateAnimatedNodeConfig(react::Tag tag, const jsi::Value &config) {
 }
 
 double NativeAnimatedTurboModule::getValue(react::Tag tag) {
-    auto lock = acquireLock();
-    auto value = m_animatedNodesManager.getValue(tag);
+    double value = 0;
+    runSyncOnAnimationThread([this, tag, &value] { value = m_animatedNodesManager.getValue(tag); });
     return value;
 }
 
 void NativeAnimatedTurboModule::startListeningToAnimatedNodeValue(jsi::Runtime &rt, react::Tag tag) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.startListeningToAnimatedNodeValue(tag, [this, tag, &rt](double value) {
-        this->emitDeviceEvent(rt, "onAnimatedValueUpdate",
-                              [tag, value](jsi::Runtime &rt, std::vector<jsi::Value> &args) {
-                                  auto payload = jsi::Object(rt);
-                                  payload.setProperty(rt, "tag", tag);
-                                  payload.setProperty(rt, "value", value);
-                                  args.push_back(std::move(payload));
-                              });
+    runOnAnimationThread([this, tag, &rt] {
+        m_animatedNodesManager.startListeningToAnimatedNodeValue(tag, [this, tag, &rt](double value) {
+            this->emitDeviceEvent(rt, "onAnimatedValueUpdate",
+                                  [tag, value](jsi::Runtime &rt, std::vector<jsi::Value> &args) {
+                                      auto payload = jsi::Object(rt);
+                                      payload.setProperty(rt, "tag", tag);
+                                      payload.setProperty(rt, "value", value);
+                                      args.push_back(std::move(payload));
+                                  });
+        });
     });
 }
 
 void NativeAnimatedTurboModule::stopListeningToAnimatedNodeValue(react::Tag tag) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.stopListeningToAnimatedNodeValue(tag);
+    runOnAnimationThread([this, tag] { m_animatedNodesManager.stopListeningToAnimatedNodeValue(tag); });
 }
 
 void NativeAnimatedTurboModule::connectAnimatedNodes(react::Tag parentNodeTag, react::Tag childNodeTag) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.connectNodes(parentNodeTag, childNodeTag);
+    runOnAnimationThread([this, parentNodeTag, childNodeTag] { m_animatedNodesManager.connectNodes(parentNodeTag, childNodeTag); });
 }
 
 void NativeAnimatedTurboModule::disconnectAnimatedNodes(react::Tag parentNodeTag, react::Tag childNodeTag) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.disconnectNodes(parentNodeTag, childNodeTag);
+    runOnAnimationThread([this, parentNodeTag, childNodeTag] { m_animatedNodesManager.disconnectNodes(parentNodeTag, childNodeTag); });
 }
 
 void NativeAnimatedTurboModule::startAnimatingNode(
@@ -341,62 +342,80 @@ void NativeAnimatedTurboModule::startAnimatingNode(
         // to ensure proper handling by React
         jsInvoker->invokeAsync([finished, endCallback = std::move(endCallback)] { endCallback(finished); });
     };
-    auto lock = acquireLock();
-    m_animatedNodesManager.startAnimatingNode(animationId, nodeTag, config, std::move(jsThreadCallback));
+    runOnAnimationThread([this, animationId, nodeTag, config, jsThreadCallback = std::move(jsThreadCallback)]() mutable {
+        m_animatedNodesManager.startAnimatingNode(animationId, nodeTag, config, std::move(jsThreadCallback));
+    });
 }
 
 void NativeAnimatedTurboModule::stopAnimation(react::Tag animationId) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.stopAnimation(animationId);
+    runOnAnimationThread([this, animationId] { m_animatedNodesManager.stopAnimation(animationId); });
 }
 
 void NativeAnimatedTurboModule::setAnimatedNodeValue(react::Tag nodeTag, double value) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.setValue(nodeTag, value);
+    runOnAnimationThread([this, nodeTag, value] { m_animatedNodesManager.setValue(nodeTag, value); });
 }
 
 void NativeAnimatedTurboModule::setAnimatedNodeOffset(react::Tag nodeTag, double offset) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.setOffset(nodeTag, offset);
+    runOnAnimationThread([this, nodeTag, offset] { m_animatedNodesManager.setOffset(nodeTag, offset); });
 }
 
 void NativeAnimatedTurboModule::flattenAnimatedNodeOffset(react::Tag nodeTag) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.flattenOffset(nodeTag);
+    runOnAnimationThread([this, nodeTag] { m_animatedNodesManager.flattenOffset(nodeTag); });
 }
 
 void NativeAnimatedTurboModule::extractAnimatedNodeOffset(react::Tag nodeTag) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.extractOffset(nodeTag);
+    runOnAnimationThread([this, nodeTag] { m_animatedNodesManager.extractOffset(nodeTag); });
 }
 
 void NativeAnimatedTurboModule::connectAnimatedNodeToView(react::Tag nodeTag, react::Tag viewTag) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.connectNodeToView(nodeTag, viewTag);
+    runOnAnimationThread([this, nodeTag, viewTag] { m_animatedNodesManager.connectNodeToView(nodeTag, viewTag); });
 }
 
 void NativeAnimatedTurboModule::disconnectAnimatedNodeFromView(react::Tag nodeTag, react::Tag viewTag) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.disconnectNodeFromView(nodeTag, viewTag);
+    runOnAnimationThread([this, nodeTag, viewTag] { m_animatedNodesManager.disconnectNodeFromView(nodeTag, viewTag); });
 }
 
 void NativeAnimatedTurboModule::restoreDefaultValues(react::Tag nodeTag) {
 }
 
 void NativeAnimatedTurboModule::dropAnimatedNode(react::Tag tag) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.dropNode(tag);
+    runOnAnimationThread([this, tag] { m_animatedNodesManager.dropNode(tag); });
 }
 
 void NativeAnimatedTurboModule::addAnimatedEventToView(react::Tag viewTag, std::string const &eventName, folly::dynamic const &eventMapping) {
-    auto lock = acquireLock();
     initializeEventListener();
-    m_animatedNodesManager.addAnimatedEventToView(viewTag, eventName, eventMapping);
+    NapiEventPath eventPath;
+    for (auto const &key : eventMapping["nativeEventPath"]) {
+        eventPath.push_back(PropertyKey::intern(key.asString()));
+    }
+    auto nodeTag = static_cast<react::Tag>(eventMapping["animatedValueTag"].asInt());
+    updateEventPaths([&](auto &eventPathsByKey) {
+        eventPathsByKey[{viewTag, eventName}].emplace_back(nodeTag, std::move(eventPath));
+    });
+    runOnAnimationThread([this, viewTag, eventName, eventMapping] {
+        m_animatedNodesManager.addAnimatedEventToView(viewTag, eventName, eventMapping);
+    });
 }
 
 void NativeAnimatedTurboModule::removeAnimatedEventFromView(facebook::react::Tag viewTag, std::string const &eventName, facebook::react::Tag animatedValueTag) {
-    auto lock = acquireLock();
-    m_animatedNodesManager.removeAnimatedEventFromView(viewTag, eventName, animatedValueTag);
+    updateEventPaths([&](auto &eventPathsByKey) {
+        auto it = eventPathsByKey.find({viewTag, eventName});
+        if (it == eventPathsByKey.end()) {
+            return;
+        }
+        auto &eventPathByNodeTag = it->second;
+        eventPathByNodeTag.erase(
+            std::remove_if(eventPathByNodeTag.begin(), eventPathByNodeTag.end(), [&](auto const &nodeTagAndPath) {
+                return nodeTagAndPath.first == animatedValueTag;
+            }),
+            eventPathByNodeTag.end());
+        if (eventPathByNodeTag.empty()) {
+            eventPathsByKey.erase(it);
+        }
+    });
+    runOnAnimationThread([this, viewTag, eventName, animatedValueTag] {
+        m_animatedNodesManager.removeAnimatedEventFromView(viewTag, eventName, animatedValueTag);
+    });
 }
 
 void NativeAnimatedTurboModule::addListener(const std::string &eventName) {
@@ -405,26 +424,51 @@ void NativeAnimatedTurboModule::addListener(const std::string &eventName) {
 void NativeAnimatedTurboModule::removeListeners(double count) {
 }
 
-void NativeAnimatedTurboModule::runUpdates() {
-    ArkJS arkJs(m_ctx.env);
-    auto lock = this->acquireLock();
+void NativeAnimatedTurboModule::requestFrame() {
+    auto onFrame = [weakSelf = weak_from_this()](FrameInfo const &frameInfo) {
+        if (auto self = weakSelf.lock()) {
+            self->runOnAnimationThread([self = self.get(), frameInfo] {
+                self->runUpdates(frameInfo.vsyncTimestampInNs, frameInfo.targetFrameIntervalInNs);
+            });
+        }
+    };
+    m_ctx.frameClock->requestFrame(
+        FrameClockPhase::ANIMATED, std::move(onFrame), m_animatedNodesManager.getMinUsefulFrameIntervalInNs());
+}
+
+void NativeAnimatedTurboModule::runUpdates(int64_t frameTimeNanos, int64_t targetFrameIntervalInNs) {
+    OH_HiTrace_StartTrace("NativeAnimatedTurboModule::runUpdates");
     try {
-        auto now = std::chrono::high_resolution_clock::now();
-        auto frameTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch());
-        this->m_animatedNodesManager.runUpdates(frameTime.count());
+        // NOTE: the vsync timestamp, shared with layout animations and timers ticking in the same frame
+        this->m_animatedNodesManager.runUpdates(frameTimeNanos, targetFrameIntervalInNs);
     } catch (std::exception &e) {
         LOG(ERROR) << "Error in animation update: " << e.what();
-        m_vsyncHandle.requestFrame(rnoh::scheduleUpdate, this);
+        this->requestFrame();
     }
+    OH_HiTrace_FinishTrace();
 }
 
-void NativeAnimatedTurboModule::setNativeProps(facebook::react::Tag tag, folly::dynamic const &props) {
+std::vector<AnimationTelemetry> NativeAnimatedTurboModule::getAnimationTelemetry() {
+    std::vector<AnimationTelemetry> result;
+    runSyncOnAnimationThread([this, &result] { result = m_animatedNodesManager.getAnimationTelemetry(); });
+    return result;
+}
+
+void NativeAnimatedTurboModule::applyPropsSnapshot() {
+    auto snapshot = m_propsSnapshotExchange.take();
+    if (snapshot == nullptr) {
+        return;
+    }
     ArkJS arkJs(m_ctx.env);
-    auto napiTag = arkJs.createInt(tag);
-    auto napiProps = arkJs.createFromDynamic(props);
+    std::vector<napi_value> napiNewPropNames;
+    napiNewPropNames.reserve(snapshot->newPropNames.size());
+    for (auto const &propName : snapshot->newPropNames) {
+        napiNewPropNames.push_back(arkJs.createString(propName));
+    }
+    auto napiBuffer = arkJs.createArrayBuffer(std::move(snapshot->buffer));
 
     auto napiTurboModuleObject = arkJs.getObject(m_ctx.arkTsTurboModuleInstanceRef);
-    napiTurboModuleObject.call("setViewProps", {napiTag, napiProps});
+    napiTurboModuleObject.call("setViewPropsBatch", {napiBuffer, arkJs.createArray(napiNewPropNames)});
 }
 
 void NativeAnimatedTurboModule::emitAnimationEndedEvent(facebook::jsi::Runtime &rt, facebook::react::Tag animationId, bool finished) {
@@ -437,14 +481,61 @@ void NativeAnimatedTurboModule::emitAnimationEndedEvent(facebook::jsi::Runtime &
                     });
 }
 
+void NativeAnimatedTurboModule::updateEventPaths(std::function<void(EventPathsByKey &)> const &update) {
+    std::lock_guard<std::mutex> lock(m_eventPathsMutex);
+    auto eventPathsByKey = std::make_shared<EventPathsByKey>(*std::atomic_load(&m_eventPathsByKey));
+    update(*eventPathsByKey);
+    std::atomic_store(&m_eventPathsByKey, std::shared_ptr<EventPathsByKey const>(std::move(eventPathsByKey)));
+}
+
+/**
+ * Reads a number at `eventPath` straight from the napi payload, without converting the rest of it.
+ */
+static std::optional<double> readEventValue(ArkJS &arkJs, napi_value payload, std::vector<PropertyKey> const &eventPath) {
+    auto value = payload;
+    for (auto const &key : eventPath) {
+        if (arkJs.getType(value) != napi_object) {
+            return std::nullopt;
+        }
+        value = arkJs.getObjectProperty(value, key);
+    }
+    if (arkJs.getType(value) != napi_number) {
+        return std::nullopt;
+    }
+    return arkJs.getDouble(value);
+}
+
 void NativeAnimatedTurboModule::handleEvent(EventEmitRequestHandler::Context const &ctx) {
+    auto eventPathsByKey = std::atomic_load(&m_eventPathsByKey);
+    auto it = eventPathsByKey->find({ctx.tag, ctx.eventName});
+    if (it == eventPathsByKey->end()) {
+        return;
+    }
+
     ArkJS arkJs(ctx.env);
-    folly::dynamic payload = arkJs.getDynamic(ctx.payload);
-    react::Tag tag = ctx.tag;
-    auto eventName = ctx.eventName;
+    std::vector<AnimatedNodesManager::EventValue> eventValues;
+    eventValues.reserve(it->second.size());
+    for (auto const &[nodeTag, eventPath] : it->second) {
+        if (auto value = readEventValue(arkJs, ctx.payload, eventPath); value.has_value()) {
+            eventValues.push_back({nodeTag, eventPath, value.value()});
+        }
+    }
+    if (eventValues.empty()) {
+        return;
+    }
+
+    runOnAnimationThread([this, tag = ctx.tag, eventName = ctx.eventName, eventValues = std::move(eventValues)] {
+        m_animatedNodesManager.handleEvent(tag, eventName, eventValues);
+    });
+}
+
+void NativeAnimatedTurboModule::runOnAnimationThread(AbstractTaskRunner::Task &&task) {
+    m_animationTaskRunner->runAsyncTask(std::move(task), TaskPriority::NORMAL);
+}
 
-    auto lock = acquireLock();
-    m_animatedNodesManager.handleEvent(tag, eventName, payload);
+void NativeAnimatedTurboModule::runSyncOnAnimationThread(AbstractTaskRunner::Task &&task) {
+    // NOTE: posted to the same lane as the operations, so operations queued before this call are applied first
+    m_animationTaskRunner->runSyncTask(std::move(task), TaskPriority::NORMAL);
 }
 
 void NativeAnimatedTurboModule::initializeEventListener() {
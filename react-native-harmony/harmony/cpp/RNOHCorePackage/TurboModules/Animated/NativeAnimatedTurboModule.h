@@ -1,19 +1,24 @@
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <react/renderer/core/ReactPrimitives.h>
 #include <react/renderer/core/EventListener.h>
 #include <RNOH/ArkTSTurboModule.h>
 #include <folly/dynamic.h>
-#include <native_vsync/native_vsync.h>
 
 #include "AnimatedNodesManager.h"
-#include "RNOH/NativeVsyncHandle.h"
+#include "AnimatedPropsBatch.h"
+#include "RNOH/AnimationTelemetry.h"
 #include "RNOH/EventEmitRequestHandler.h"
+#include "RNOH/PropertyKey.h"
+#include "RNOH/TaskExecutor/ThreadTaskRunner.h"
 
 namespace rnoh {
 
-class NativeAnimatedTurboModule : public rnoh::ArkTSTurboModule, public rnoh::EventEmitRequestHandler, public std::enable_shared_from_this<NativeAnimatedTurboModule> {
+class NativeAnimatedTurboModule : public rnoh::ArkTSTurboModule, public rnoh::EventEmitRequestHandler, public rnoh::AnimationTelemetryProvider, public std::enable_shared_from_this<NativeAnimatedTurboModule> {
 
   public:
     using Context = rnoh::ArkTSTurboModule::Context;
@@ -71,9 +76,30 @@ class NativeAnimatedTurboModule : public rnoh::ArkTSTurboModule, public rnoh::Ev
 
     void removeListeners(double count);
 
-    void runUpdates();
-
-    void setNativeProps(facebook::react::Tag tag, folly::dynamic const &props);
+    /**
+     * Evaluates the nodes graph. Called on the animation thread.
+     */
+    void runUpdates(int64_t frameTimeNanos, int64_t targetFrameIntervalInNs);
+
+    /**
+     * Frame statistics of running and recently ended animations. Blocks until the animation thread finishes the
+     * operations queued before the call, so it may be called from any thread except that one.
+     */
+    std::vector<AnimationTelemetry> getAnimationTelemetry() override;
+
+    /**
+     * Applies the latest props published by the animation thread. Called on the main thread.
+     */
+    void applyPropsSnapshot();
+
+    /**
+     * The nodes graph is owned by the animation thread; JS thread calls and events are queued as operations on it.
+     */
+    void runOnAnimationThread(AbstractTaskRunner::Task &&task);
+    /**
+     * Blocks until `task` has run on the animation thread, after every operation queued before it.
+     */
+    void runSyncOnAnimationThread(AbstractTaskRunner::Task &&task);
 
     void emitAnimationEndedEvent(facebook::jsi::Runtime &rt, facebook::react::Tag animationId, bool completed);
 
@@ -81,19 +107,31 @@ class NativeAnimatedTurboModule : public rnoh::ArkTSTurboModule, public rnoh::Ev
     void handleEvent(EventEmitRequestHandler::Context const &ctx) override;
 
   private:
-    std::unique_lock<std::mutex> acquireLock() {
-        return std::unique_lock(m_nodesManagerLock);
-    }
+    // NOTE: keys are interned when the event is registered, so reading the payload doesn't create napi strings
+    using NapiEventPath = std::vector<PropertyKey>;
+    using EventPathByNodeTag = std::vector<std::pair<facebook::react::Tag, NapiEventPath>>;
+    using EventPathsByKey = std::unordered_map<AnimatedEventKey, EventPathByNodeTag, AnimatedEventKeyHash>;
+
+    void updateEventPaths(std::function<void(EventPathsByKey &)> const &update);
 
     // `shared_from_this` cannot be used in constructor,
     // so we defer the initialization of the event listener
     // until the first animated event is registered.
     void initializeEventListener();
 
-    NativeVsyncHandle m_vsyncHandle;
+    void requestFrame();
+
+    AnimatedPropsSnapshotExchange m_propsSnapshotExchange;
     AnimatedNodesManager m_animatedNodesManager;
-    std::mutex m_nodesManagerLock;
     bool m_initializedEventListener = false;
+    /**
+     * Paths of values the animated events need, read on the main thread straight from the napi payload.
+     * Copied on write (under m_eventPathsMutex), read without locking the writers out via std::atomic_load.
+     */
+    std::shared_ptr<EventPathsByKey const> m_eventPathsByKey = std::make_shared<EventPathsByKey>();
+    std::mutex m_eventPathsMutex;
+    // NOTE: declared last, so the animation thread stops before the state it uses is destroyed
+    std::unique_ptr<ThreadTaskRunner> m_animationTaskRunner;
 };
 
 } // namespace rnoh
\ No newline at end of file
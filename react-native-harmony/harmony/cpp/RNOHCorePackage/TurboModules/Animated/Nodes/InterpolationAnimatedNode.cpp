@@ -1,25 +1,150 @@
 #include "InterpolationAnimatedNode.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <regex>
+#include <folly/Conv.h>
+
 using namespace facebook;
 
 namespace rnoh {
 
-size_t findRangeIndex(double value, folly::dynamic const &inputRange) {
-    size_t index = 1;
-    while (index < inputRange.size() - 1 && inputRange[index].asDouble() < value) {
-        index++;
+static constexpr size_t COLOR_CHANNELS_COUNT = 4;
+
+static std::array<double, COLOR_CHANNELS_COUNT> colorChannelsFromArgb(uint32_t argb) {
+    return std::array<double, COLOR_CHANNELS_COUNT>{
+        static_cast<double>((argb >> 16) & 0xFF),
+        static_cast<double>((argb >> 8) & 0xFF),
+        static_cast<double>(argb & 0xFF),
+        static_cast<double>((argb >> 24) & 0xFF)};
+}
+
+/**
+ * Parses "#rgb", "#rgba", "#rrggbb", "#rrggbbaa", "rgb(r, g, b)", "rgba(r, g, b, a)" and "transparent" into
+ * r, g, b, a channels in the [0, 255] range.
+ */
+static std::optional<std::array<double, COLOR_CHANNELS_COUNT>> parseColor(std::string const &color) {
+    if (color == "transparent") {
+        return std::array<double, COLOR_CHANNELS_COUNT>{0, 0, 0, 0};
     }
-    return index - 1;
+    if (!color.empty() && color[0] == '#') {
+        auto hex = color.substr(1);
+        if (hex.size() == 3 || hex.size() == 4) {
+            std::string expandedHex;
+            for (auto c : hex) {
+                expandedHex += {c, c};
+            }
+            hex = expandedHex;
+        }
+        if (hex.size() == 6) {
+            hex += "ff";
+        }
+        if (hex.size() != 8 || hex.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos) {
+            return std::nullopt;
+        }
+        auto rgba = static_cast<uint32_t>(std::stoul(hex, nullptr, 16));
+        return colorChannelsFromArgb((rgba >> 8) | (rgba << 24));
+    }
+    static const std::regex rgbaRegex(
+        R"(^\s*rgba?\(\s*([\d.]+)\s*,\s*([\d.]+)\s*,\s*([\d.]+)\s*(?:,\s*([\d.]+)\s*)?\)\s*$)");
+    std::smatch match;
+    if (!std::regex_match(color, match, rgbaRegex)) {
+        return std::nullopt;
+    }
+    return std::array<double, COLOR_CHANNELS_COUNT>{
+        std::stod(match[1]),
+        std::stod(match[2]),
+        std::stod(match[3]),
+        match[4].matched ? std::stod(match[4]) * 255 : 255};
+}
+
+static uint32_t colorChannelToByte(double channel) {
+    return static_cast<uint32_t>(std::round(std::clamp(channel, 0.0, 255.0)));
 }
 
 InterpolationAnimatedNode::InterpolationAnimatedNode(folly::dynamic const &config, AnimatedNodesManager &nodesManager)
     : m_nodesManager(nodesManager) {
-    m_inputRange = config["inputRange"];
-    m_outputRange = config["outputRange"];
+    for (auto const &input : config["inputRange"]) {
+        m_inputRange.push_back(input.asDouble());
+    }
+    if (m_inputRange.size() < 2) {
+        throw std::runtime_error("inputRange must have at least 2 elements");
+    }
+    decodeOutputRange(config);
     m_extrapolateLeft = extrapolateTypeFromString(config["extrapolateLeft"].asString());
     m_extrapolateRight = extrapolateTypeFromString(config["extrapolateRight"].asString());
 }
 
+void InterpolationAnimatedNode::decodeOutputRange(folly::dynamic const &config) {
+    auto const &outputRange = config["outputRange"];
+    if (outputRange.size() != m_inputRange.size()) {
+        throw std::runtime_error("inputRange and outputRange must have the same length");
+    }
+    auto outputType = config.getDefault("outputType", nullptr);
+
+    if (outputRange[0].isNumber() && outputType != "color") {
+        m_outputType = OutputType::NUMBER;
+        m_componentsPerOutput = 1;
+        for (auto const &output : outputRange) {
+            m_outputComponents.push_back(output.asDouble());
+        }
+    } else {
+        std::vector<std::array<double, COLOR_CHANNELS_COUNT>> colors;
+        for (auto const &output : outputRange) {
+            auto color = output.isNumber()
+                ? std::optional(colorChannelsFromArgb(static_cast<uint32_t>(static_cast<int64_t>(output.asDouble()))))
+                : parseColor(output.asString());
+            if (!color.has_value()) {
+                break;
+            }
+            colors.push_back(color.value());
+        }
+        if (colors.size() == outputRange.size()) {
+            m_outputType = OutputType::COLOR;
+            m_componentsPerOutput = COLOR_CHANNELS_COUNT;
+            for (auto const &color : colors) {
+                m_outputComponents.insert(m_outputComponents.end(), color.begin(), color.end());
+            }
+        } else {
+            m_outputType = OutputType::STRING;
+            static const std::regex numberRegex(R"([+-]?(?:\d+\.?\d*|\.\d+)(?:[eE][+-]?\d+)?)");
+            for (size_t outputIdx = 0; outputIdx < outputRange.size(); outputIdx++) {
+                auto const &outputString = outputRange[outputIdx].getString();
+                // NOTE: the pattern is taken from the first output
+                auto isFirstOutput = outputIdx == 0;
+                size_t numbersCount = 0;
+                auto partBegin = outputString.begin();
+                for (auto it = std::sregex_iterator(outputString.begin(), outputString.end(), numberRegex); it != std::sregex_iterator(); ++it) {
+                    m_outputComponents.push_back(std::stod(it->str()));
+                    if (isFirstOutput) {
+                        m_outputPatternParts.emplace_back(partBegin, (*it)[0].first);
+                    }
+                    partBegin = (*it)[0].second;
+                    numbersCount++;
+                }
+                if (isFirstOutput) {
+                    m_outputPatternParts.emplace_back(partBegin, outputString.end());
+                    m_componentsPerOutput = numbersCount;
+                } else if (numbersCount != m_componentsPerOutput) {
+                    throw std::runtime_error("Invalid pattern " + outputString + ", expected " + std::to_string(m_componentsPerOutput) + " numbers");
+                }
+            }
+        }
+    }
+    m_interpolatedComponents.resize(m_componentsPerOutput);
+    m_outputComponentDeltas.resize(m_outputComponents.size() - m_componentsPerOutput);
+    for (size_t i = 0; i < m_outputComponentDeltas.size(); i++) {
+        m_outputComponentDeltas[i] = m_outputComponents[i + m_componentsPerOutput] - m_outputComponents[i];
+    }
+}
+
+size_t InterpolationAnimatedNode::findRangeIndex(double value) const {
+    // first input in [1, size - 1) which is not less than `value`, or the last one
+    auto it = std::lower_bound(m_inputRange.begin() + 1, m_inputRange.end() - 1, value);
+    return static_cast<size_t>(it - m_inputRange.begin()) - 1;
+}
+
 void InterpolationAnimatedNode::update() {
     if (m_parent == std::nullopt) {
         // this can occur if the graph is still being constructed
@@ -30,17 +155,34 @@ void InterpolationAnimatedNode::update() {
     auto &parentNode = getParentNode();
     double value = parentNode.getValue();
 
-    auto rangeIndex = findRangeIndex(value, m_inputRange);
-
-    // TODO: string and color interpolation
-    m_value = interpolate(
-        value,
-        m_inputRange[rangeIndex].asDouble(),
-        m_inputRange[rangeIndex + 1].asDouble(),
-        m_outputRange[rangeIndex].asDouble(),
-        m_outputRange[rangeIndex + 1].asDouble(),
-        m_extrapolateLeft,
-        m_extrapolateRight);
+    interpolateComponents(value, findRangeIndex(value));
+
+    switch (m_outputType) {
+    case OutputType::NUMBER:
+        m_value = m_interpolatedComponents[0];
+        break;
+    case OutputType::COLOR: {
+        auto argb = (colorChannelToByte(m_interpolatedComponents[3]) << 24) |
+            (colorChannelToByte(m_interpolatedComponents[0]) << 16) |
+            (colorChannelToByte(m_interpolatedComponents[1]) << 8) | colorChannelToByte(m_interpolatedComponents[2]);
+        m_value = static_cast<double>(argb);
+        break;
+    }
+    case OutputType::STRING: {
+        std::string result = m_outputPatternParts[0];
+        for (size_t i = 0; i < m_componentsPerOutput; i++) {
+            result += folly::to<std::string>(m_interpolatedComponents[i]);
+            result += m_outputPatternParts[i + 1];
+        }
+        m_value = m_componentsPerOutput > 0 ? m_interpolatedComponents[0] : 0;
+        m_stringValue = std::move(result);
+        break;
+    }
+    }
+}
+
+std::optional<std::string> InterpolationAnimatedNode::getStringValue() const {
+    return m_stringValue;
 }
 
 void InterpolationAnimatedNode::onAttachedToNode(facebook::react::Tag tag) {
@@ -55,58 +197,46 @@ void InterpolationAnimatedNode::onDetachedFromNode(facebook::react::Tag tag) {
     m_parent = std::nullopt;
 }
 
-double InterpolationAnimatedNode::interpolate(
-    double value,
-    double inputMin,
-    double inputMax,
-    double outputMin,
-    double outputMax,
-    ExtrapolateType extrapolateLeft,
-    ExtrapolateType extrapolateRight) const {
-    double result = value;
-
-    if (result < inputMin) {
-        if (extrapolateLeft == ExtrapolateType::EXTRAPOLATE_TYPE_IDENTITY) {
-            return result;
-        } else if (extrapolateLeft == ExtrapolateType::EXTRAPOLATE_TYPE_CLAMP) {
-            result = inputMin;
-        } else if (extrapolateLeft == ExtrapolateType::EXTRAPOLATE_TYPE_EXTEND) {
-            // noop
-        } else {
-            // this should never happen, since we've already checked the extrapolation type
-            throw std::runtime_error("Invalid extrapolation type for left extrapolation");
-        }
-    }
+void InterpolationAnimatedNode::interpolateComponents(double value, size_t rangeIndex) {
+    auto inputMin = m_inputRange[rangeIndex];
+    auto inputMax = m_inputRange[rangeIndex + 1];
+    double input = value;
 
-    if (result > inputMax) {
-        if (extrapolateRight == ExtrapolateType::EXTRAPOLATE_TYPE_IDENTITY) {
-            return result;
-        } else if (extrapolateRight == ExtrapolateType::EXTRAPOLATE_TYPE_CLAMP) {
-            result = inputMax;
-        } else if (extrapolateRight == ExtrapolateType::EXTRAPOLATE_TYPE_EXTEND) {
-            // noop
-        } else {
-            // this should never happen
-            throw std::runtime_error("Invalid extrapolation type for right extrapolation");
+    if (input < inputMin) {
+        if (m_extrapolateLeft == ExtrapolateType::EXTRAPOLATE_TYPE_IDENTITY) {
+            std::fill(m_interpolatedComponents.begin(), m_interpolatedComponents.end(), value);
+            return;
+        } else if (m_extrapolateLeft == ExtrapolateType::EXTRAPOLATE_TYPE_CLAMP) {
+            input = inputMin;
         }
     }
 
-    if (outputMin == outputMax) {
-        return outputMin;
+    if (input > inputMax) {
+        if (m_extrapolateRight == ExtrapolateType::EXTRAPOLATE_TYPE_IDENTITY) {
+            std::fill(m_interpolatedComponents.begin(), m_interpolatedComponents.end(), value);
+            return;
+        } else if (m_extrapolateRight == ExtrapolateType::EXTRAPOLATE_TYPE_CLAMP) {
+            input = inputMax;
+        }
     }
 
+    auto outputsMin = m_outputComponents.data() + rangeIndex * m_componentsPerOutput;
+    auto outputDeltas = m_outputComponentDeltas.data() + rangeIndex * m_componentsPerOutput;
+    double progress = 0;
     if (inputMin == inputMax) {
         if (value >= inputMax) {
-            return outputMax;
-        } else {
-            return outputMin;
+            outputsMin += m_componentsPerOutput;
         }
+    } else {
+        progress = (input - inputMin) / (inputMax - inputMin);
     }
 
-    double inputRange = inputMax - inputMin;
-    double outputRange = outputMax - outputMin;
-
-    return outputMin + outputRange * (result - inputMin) / inputRange;
+    // NOTE: the range and the extrapolation are resolved above, once for all components, so this loop has no branches
+    // and the compiler can vectorize it
+    auto interpolatedComponents = m_interpolatedComponents.data();
+    for (size_t i = 0; i < m_componentsPerOutput; i++) {
+        interpolatedComponents[i] = outputsMin[i] + outputDeltas[i] * progress;
+    }
 }
 
 ValueAnimatedNode &InterpolationAnimatedNode::getParentNode() const {
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "AnimatedNode.h"
 #include "RNOHCorePackage/TurboModules/Animated/AnimatedNodesManager.h"
@@ -18,6 +20,8 @@ public:
     void onAttachedToNode(facebook::react::Tag tag) override;
     void onDetachedFromNode(facebook::react::Tag tag) override;
 
+    std::optional<std::string> getStringValue() const override;
+
 private:
     enum ExtrapolateType {
         EXTRAPOLATE_TYPE_IDENTITY,
@@ -25,25 +29,37 @@ private:
         EXTRAPOLATE_TYPE_EXTEND
     };
 
+    enum class OutputType {
+        NUMBER,
+        // ARGB colors; interpolated per channel and emitted as a number
+        COLOR,
+        // strings with the same pattern of numbers, e.g. "0px 10px"; numbers are interpolated, the rest is copied
+        STRING,
+    };
+
     static ExtrapolateType extrapolateTypeFromString(std::string const &extrapolateType);
 
+    void decodeOutputRange(folly::dynamic const &config);
+    size_t findRangeIndex(double value) const;
+
     ExtrapolateType m_extrapolateLeft;
     ExtrapolateType m_extrapolateRight;
-    
-    double interpolate(
-        double value,
-        double inputMin,
-        double inputMax,
-        double outputMin,
-        double outputMax,
-        ExtrapolateType extrapolateLeft,
-        ExtrapolateType extrapolateRight
-    ) const;
+
+    void interpolateComponents(double value, size_t rangeIndex);
 
     ValueAnimatedNode &getParentNode() const;
 
-    folly::dynamic m_inputRange;
-    folly::dynamic m_outputRange;
+    std::vector<double> m_inputRange;
+    OutputType m_outputType = OutputType::NUMBER;
+    size_t m_componentsPerOutput = 1;
+    // m_componentsPerOutput components of each output, stored contiguously
+    std::vector<double> m_outputComponents;
+    // differences between the components of consecutive outputs, m_componentsPerOutput for each range
+    std::vector<double> m_outputComponentDeltas;
+    std::vector<double> m_interpolatedComponents;
+    // parts of the string pattern around the numbers, m_componentsPerOutput + 1 of them
+    std::vector<std::string> m_outputPatternParts;
+    std::optional<std::string> m_stringValue;
 
     std::optional<facebook::react::Tag> m_parent;
     AnimatedNodesManager &m_nodesManager;
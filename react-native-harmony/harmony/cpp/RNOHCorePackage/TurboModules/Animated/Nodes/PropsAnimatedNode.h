@@ -6,7 +6,7 @@
 
 #include <glog/logging.h>
 #include <folly/dynamic.h>
-#include <unordered_map>
+#include <vector>
 
 namespace rnoh {
 
@@ -16,7 +16,9 @@ public:
         : m_nodesManager(nodesManager) 
     {
         for (auto const &entry : config["props"].items()) {
-            m_tagByPropName[entry.first.asString()] = entry.second.asDouble();
+            m_props.push_back({
+                .propId = m_nodesManager.internPropName(entry.first.asString()),
+                .nodeTag = static_cast<facebook::react::Tag>(entry.second.asDouble())});
         }
     }
 
@@ -31,29 +33,63 @@ public:
         m_viewTag = std::nullopt;
     }
 
+    void onAttachedToNode(facebook::react::Tag tag) override {
+        // NOTE: node types are resolved once the nodes are connected, so updateView() doesn't cast them on every frame
+        for (auto &prop : m_props) {
+            if (prop.nodeTag == tag) {
+                prop.nodeType = resolveNodeType(m_nodesManager.getNodeByTag(tag));
+            }
+        }
+    }
+
     void updateView() {
         if (m_viewTag == std::nullopt) {
             LOG(WARNING) << "PropsAnimatedNode::updateView() called on unconnected node";
             return;
         }
-        folly::dynamic props = folly::dynamic::object;
-        for (auto &[key, nodeTag] : m_tagByPropName) {
-            auto node = &m_nodesManager.getNodeByTag(nodeTag);
-            if (auto styleNode = dynamic_cast<StyleAnimatedNode*>(node); styleNode != nullptr) {
-                props.update(styleNode->getStyle());
-            } else if (auto valueNode = dynamic_cast<ValueAnimatedNode*>(node); valueNode != nullptr) {
-                props[key] = valueNode->getValue();
-            } else {
-                throw std::runtime_error("Unsupported property animated node type");
+        auto &propsBatch = m_nodesManager.getPropsBatch();
+        for (auto &prop : m_props) {
+            auto &node = m_nodesManager.getNodeByTag(prop.nodeTag);
+            if (prop.nodeType == NodeType::UNRESOLVED) {
+                prop.nodeType = resolveNodeType(node);
+            }
+            switch (prop.nodeType) {
+            case NodeType::STYLE:
+                static_cast<StyleAnimatedNode &>(node).addStyleToBatch(propsBatch, *m_viewTag);
+                break;
+            case NodeType::VALUE:
+                propsBatch.addValue(*m_viewTag, prop.propId, static_cast<ValueAnimatedNode &>(node));
+                break;
+            case NodeType::UNRESOLVED:
+                break;
             }
         }
-
-        m_nodesManager.m_setNativePropsFn(*m_viewTag, props);
     }
 
 private:
+    enum class NodeType {
+        UNRESOLVED,
+        STYLE,
+        VALUE,
+    };
+
+    struct Prop {
+        AnimatedPropId propId;
+        facebook::react::Tag nodeTag;
+        NodeType nodeType = NodeType::UNRESOLVED;
+    };
+
+    static NodeType resolveNodeType(AnimatedNode &node) {
+        if (dynamic_cast<StyleAnimatedNode *>(&node) != nullptr) {
+            return NodeType::STYLE;
+        } else if (dynamic_cast<ValueAnimatedNode *>(&node) != nullptr) {
+            return NodeType::VALUE;
+        }
+        throw std::runtime_error("Unsupported property animated node type");
+    }
+
     std::optional<facebook::react::Tag> m_viewTag;
-    std::unordered_map<std::string, facebook::react::Tag> m_tagByPropName;
+    std::vector<Prop> m_props;
     AnimatedNodesManager &m_nodesManager;
 };
 
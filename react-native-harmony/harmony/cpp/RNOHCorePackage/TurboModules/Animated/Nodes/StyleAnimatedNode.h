@@ -5,6 +5,7 @@
 #include "RNOHCorePackage/TurboModules/Animated/AnimatedNodesManager.h"
 
 #include <folly/dynamic.h>
+#include <vector>
 
 namespace rnoh {
 
@@ -14,27 +15,65 @@ public:
         : m_nodesManager(nodesManager) 
     {
         for (auto const &entry : config["style"].items()) {
-            m_tagByPropName[entry.first.asString()] = entry.second.asDouble();
+            m_styleProps.push_back({
+                .propId = m_nodesManager.internPropName(entry.first.asString()),
+                .nodeTag = static_cast<facebook::react::Tag>(entry.second.asDouble())});
         }
     }
 
-    folly::dynamic getStyle() const {
-        folly::dynamic style = folly::dynamic::object;
-        for (auto &[key, nodeTag] : m_tagByPropName) {
-            auto node = &m_nodesManager.getNodeByTag(nodeTag);
-            if (auto valueNode = dynamic_cast<ValueAnimatedNode*>(node); valueNode != nullptr) {
-                style[key] = valueNode->getValue();
-            } else if (auto transformNode = dynamic_cast<TransformAnimatedNode*>(node); transformNode != nullptr) {
-                style[key] = transformNode->getTransform();
-            } else {
-                throw std::runtime_error("Unsupported style animated node type");
+    void onAttachedToNode(facebook::react::Tag tag) override {
+        // NOTE: node types are resolved once the nodes are connected, so addStyleToBatch() doesn't cast them on every
+        // frame
+        for (auto &styleProp : m_styleProps) {
+            if (styleProp.nodeTag == tag) {
+                styleProp.nodeType = resolveNodeType(m_nodesManager.getNodeByTag(tag));
+            }
+        }
+    }
+
+    void addStyleToBatch(AnimatedPropsBatch &propsBatch, facebook::react::Tag viewTag) {
+        for (auto &styleProp : m_styleProps) {
+            auto &node = m_nodesManager.getNodeByTag(styleProp.nodeTag);
+            if (styleProp.nodeType == NodeType::UNRESOLVED) {
+                styleProp.nodeType = resolveNodeType(node);
+            }
+            switch (styleProp.nodeType) {
+            case NodeType::VALUE:
+                propsBatch.addValue(viewTag, styleProp.propId, static_cast<ValueAnimatedNode &>(node));
+                break;
+            case NodeType::TRANSFORM:
+                propsBatch.addMatrix(
+                    viewTag, styleProp.propId, static_cast<TransformAnimatedNode &>(node).getTransformMatrix());
+                break;
+            case NodeType::UNRESOLVED:
+                break;
             }
         }
-        return style;
     }
 
 private:
-    std::unordered_map<std::string, facebook::react::Tag> m_tagByPropName;
+    enum class NodeType {
+        UNRESOLVED,
+        VALUE,
+        TRANSFORM,
+    };
+
+    struct StyleProp {
+        AnimatedPropId propId;
+        facebook::react::Tag nodeTag;
+        NodeType nodeType = NodeType::UNRESOLVED;
+    };
+
+    static NodeType resolveNodeType(AnimatedNode &node) {
+        if (dynamic_cast<ValueAnimatedNode *>(&node) != nullptr) {
+            return NodeType::VALUE;
+        } else if (dynamic_cast<TransformAnimatedNode *>(&node) != nullptr) {
+            return NodeType::TRANSFORM;
+        }
+        throw std::runtime_error("Unsupported style animated node type");
+    }
+
+    std::vector<StyleProp> m_styleProps;
     AnimatedNodesManager &m_nodesManager;
 };
 
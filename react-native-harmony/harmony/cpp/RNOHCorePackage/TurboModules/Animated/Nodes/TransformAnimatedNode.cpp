@@ -35,28 +35,6 @@ static Transform applyTransformOperation(Transform const &transform, std::string
     return transform * operation;
 }
 
-
-static folly::dynamic transformToDynamic(Transform const &transform) {
-    auto const &matrix = transform.matrix;
-    return folly::dynamic::array(
-        matrix[0],
-        matrix[1],
-        matrix[2],
-        matrix[3],
-        matrix[4],
-        matrix[5],
-        matrix[6],
-        matrix[7],
-        matrix[8],
-        matrix[9],
-        matrix[10],
-        matrix[11],
-        matrix[12],
-        matrix[13],
-        matrix[14],
-        matrix[15]);
-}
-
 TransformAnimatedNode::TransformAnimatedNode(folly::dynamic const &config, AnimatedNodesManager &nodesManager)
     : m_nodesManager(nodesManager) {
     auto transforms = config["transforms"];
@@ -75,7 +53,7 @@ TransformAnimatedNode::TransformAnimatedNode(folly::dynamic const &config, Anima
     }
 }
 
-folly::dynamic TransformAnimatedNode::getTransform() const {
+std::array<react::Float, 16> TransformAnimatedNode::getTransformMatrix() const {
     Transform transform;
     for (auto config : m_transforms) {
         double value;
@@ -93,7 +71,7 @@ folly::dynamic TransformAnimatedNode::getTransform() const {
 
         transform = applyTransformOperation(transform, property, value);
     }
-    return transformToDynamic(transform);
+    return transform.matrix;
 }
 
 } // namespace rnoh
\ No newline at end of file
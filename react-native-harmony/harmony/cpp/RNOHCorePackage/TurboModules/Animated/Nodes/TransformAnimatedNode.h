@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <variant>
 #include <folly/dynamic.h>
 #include <react/renderer/graphics/Transform.h>
@@ -13,7 +14,7 @@ class TransformAnimatedNode : public AnimatedNode {
   public:
     TransformAnimatedNode(folly::dynamic const &config, AnimatedNodesManager &nodesManager);
 
-    folly::dynamic getTransform() const;
+    std::array<facebook::react::Float, 16> getTransformMatrix() const;
 
   private:
     using NodeTag = facebook::react::Tag;
@@ -3,6 +3,8 @@
 #include "AnimatedNode.h"
 
 #include <folly/dynamic.h>
+#include <optional>
+#include <string>
 
 namespace rnoh {
 
@@ -21,6 +23,14 @@ public:
         return m_value + m_offset;
     }
 
+    /**
+     * Set by nodes with non-numeric output (e.g. string interpolation); takes precedence over getValue() when
+     * the value is applied to a view.
+     */
+    virtual std::optional<std::string> getStringValue() const {
+        return std::nullopt;
+    }
+
     void setValue(double value) {
         m_value = value;
     }
@@ -1,15 +1,21 @@
 #include "TimingTurboModule.h"
+#include <algorithm>
+#include <cxxreact/Instance.h>
 
 namespace rnoh {
 
 using namespace facebook;
 
+// NOTE: setInterval(fn, 0) shouldn't keep the JS thread busy
+static constexpr auto MIN_REPEAT_INTERVAL = std::chrono::milliseconds(1);
+
 static jsi::Value __hostFunction_TimingTurboModule_createTimer(
     jsi::Runtime &rt,
     react::TurboModule &turboModule,
     const jsi::Value *args,
     size_t count) {
-    static_cast<ArkTSTurboModule &>(turboModule).scheduleCall(rt, "createTimer", args, count);
+    static_cast<TimingTurboModule &>(turboModule)
+        .createTimer(args[0].asNumber(), args[1].asNumber(), args[2].asNumber(), args[3].asBool());
     return jsi::Value::undefined();
 }
 static jsi::Value __hostFunction_TimingTurboModule_deleteTimer(
@@ -17,7 +23,7 @@ static jsi::Value __hostFunction_TimingTurboModule_deleteTimer(
     react::TurboModule &turboModule,
     const jsi::Value *args,
     size_t count) {
-    static_cast<ArkTSTurboModule &>(turboModule).scheduleCall(rt, "deleteTimer", args, count);
+    static_cast<TimingTurboModule &>(turboModule).deleteTimer(args[0].asNumber());
     return jsi::Value::undefined();
 }
 static jsi::Value __hostFunction_TimingTurboModule_setSendIdleEvents(
@@ -25,7 +31,7 @@ static jsi::Value __hostFunction_TimingTurboModule_setSendIdleEvents(
     react::TurboModule &turboModule,
     const jsi::Value *args,
     size_t count) {
-    static_cast<ArkTSTurboModule &>(turboModule).scheduleCall(rt, "setSendIdleEvents", args, count);
+    static_cast<TimingTurboModule &>(turboModule).setSendIdleEvents(args[0].asBool());
     return jsi::Value::undefined();
 }
 
@@ -37,4 +43,177 @@ TimingTurboModule::TimingTurboModule(const ArkTSTurboModule::Context ctx, const
     };
 }
 
-} // namespace rnoh
\ No newline at end of file
+TimingTurboModule::~TimingTurboModule() {
+    if (m_unsubscribeFromFrames != nullptr) {
+        m_unsubscribeFromFrames();
+    }
+    // NOTE: pending delayed tasks hold a weak reference and become no-ops
+}
+
+void TimingTurboModule::createTimer(JSTimerId id, double durationInMs, double jsSchedulingTime, bool repeats) {
+    deleteTimer(id);
+    auto now = std::chrono::steady_clock::now();
+    auto &timer = m_timerById[id];
+    timer.duration = std::chrono::milliseconds(static_cast<int64_t>(std::max(durationInMs, 0.0)));
+    timer.repeats = repeats;
+    auto deadline = now + timer.duration;
+    if (!repeats) {
+        // NOTE: the time between scheduling the timer in JS and this call counts towards its duration
+        auto jsNow = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+        auto delay = std::chrono::milliseconds(std::max<int64_t>(jsNow - static_cast<int64_t>(jsSchedulingTime), 0));
+        deadline -= std::min(delay, timer.duration);
+    }
+    scheduleTimer(id, timer, deadline);
+}
+
+void TimingTurboModule::deleteTimer(JSTimerId id) {
+    m_timerIdsFiredWhilePaused.erase(
+        std::remove(m_timerIdsFiredWhilePaused.begin(), m_timerIdsFiredWhilePaused.end(), id),
+        m_timerIdsFiredWhilePaused.end());
+    auto it = m_timerById.find(id);
+    if (it == m_timerById.end()) {
+        return;
+    }
+    m_ctx.taskExecutor->cancelDelayedTask(TaskThread::JS, it->second.delayedTaskId);
+    m_timerById.erase(it);
+}
+
+void TimingTurboModule::setSendIdleEvents(bool enabled) {
+    if (!enabled) {
+        if (m_unsubscribeFromFrames != nullptr) {
+            m_unsubscribeFromFrames();
+            m_unsubscribeFromFrames = nullptr;
+        }
+        return;
+    }
+    if (m_unsubscribeFromFrames != nullptr) {
+        return;
+    }
+    m_unsubscribeFromFrames = m_ctx.frameClock->subscribe(
+        FrameClockPhase::TIMERS,
+        [weakSelf = weak_from_this(), taskExecutor = m_ctx.taskExecutor](FrameInfo const &frameInfo) {
+            auto self = weakSelf.lock();
+            if (self == nullptr || self->m_isIdleCallbackPending.exchange(true)) {
+                return;
+            }
+            // NOTE: the IDLE lane postpones the task until there is slack left in the frame
+            taskExecutor->runTask(
+                TaskThread::JS,
+                [weakSelf, frameInfo] {
+                    if (auto self = weakSelf.lock()) {
+                        self->m_isIdleCallbackPending = false;
+                        self->callIdleCallbacks(frameInfo);
+                    }
+                },
+                TaskPriority::IDLE);
+        });
+}
+
+void TimingTurboModule::onForeground() {
+    resume();
+}
+
+void TimingTurboModule::onBackground() {
+    pause();
+}
+
+void TimingTurboModule::pause() {
+    m_isPaused = true;
+}
+
+void TimingTurboModule::resume() {
+    m_isPaused = false;
+    auto timerIds = std::move(m_timerIdsFiredWhilePaused);
+    m_timerIdsFiredWhilePaused.clear();
+    if (timerIds.empty()) {
+        return;
+    }
+    callTimers(timerIds);
+    auto now = std::chrono::steady_clock::now();
+    for (auto id : timerIds) {
+        if (auto it = m_timerById.find(id); it != m_timerById.end()) {
+            scheduleTimer(id, it->second, now + std::max(it->second.duration, MIN_REPEAT_INTERVAL));
+        }
+    }
+}
+
+void TimingTurboModule::scheduleTimer(JSTimerId id, Timer &timer, std::chrono::steady_clock::time_point deadline) {
+    timer.deadline = deadline;
+    timer.delayedTaskId = m_ctx.taskExecutor->runDelayedTask(
+        TaskThread::JS,
+        [weakSelf = weak_from_this(), id] {
+            if (auto self = weakSelf.lock()) {
+                self->onTimerFired(id);
+            }
+        },
+        deadline);
+}
+
+void TimingTurboModule::onTimerFired(JSTimerId id) {
+    auto it = m_timerById.find(id);
+    if (it == m_timerById.end()) {
+        return;
+    }
+    auto &timer = it->second;
+    if (m_isPaused) {
+        m_timerIdsFiredWhilePaused.push_back(id);
+        if (!timer.repeats) {
+            m_timerById.erase(it);
+        }
+        return;
+    }
+    if (m_firedTimerIds.empty()) {
+        // NOTE: all timers due at once fire before this task runs, so they are called in one batch
+        m_ctx.taskExecutor->runTask(TaskThread::JS, [weakSelf = weak_from_this()] {
+            if (auto self = weakSelf.lock()) {
+                auto timerIds = std::move(self->m_firedTimerIds);
+                self->m_firedTimerIds.clear();
+                self->callTimers(timerIds);
+            }
+        });
+    }
+    m_firedTimerIds.push_back(id);
+    if (timer.repeats) {
+        // NOTE: the next deadline follows the previous one rather than the time this task ran, so intervals don't drift;
+        // periods missed while the JS thread was busy are skipped
+        auto interval = std::max(timer.duration, MIN_REPEAT_INTERVAL);
+        auto now = std::chrono::steady_clock::now();
+        auto deadline = timer.deadline + interval;
+        if (deadline <= now) {
+            deadline += ((now - deadline) / interval + 1) * interval;
+        }
+        scheduleTimer(id, timer, deadline);
+    } else {
+        m_timerById.erase(it);
+    }
+}
+
+void TimingTurboModule::callTimers(std::vector<JSTimerId> const &ids) {
+    folly::dynamic timerIds = folly::dynamic::array();
+    for (auto id : ids) {
+        timerIds.push_back(id);
+    }
+    callJSTimers("callTimers", folly::dynamic::array(std::move(timerIds)));
+}
+
+void TimingTurboModule::callIdleCallbacks(FrameInfo const &frameInfo) {
+    if (m_isPaused) {
+        return;
+    }
+    // NOTE: JSTimers expects the frame start as a wall-clock time
+    auto timeSinceFrameStart = std::chrono::steady_clock::now().time_since_epoch() -
+                               std::chrono::nanoseconds(frameInfo.vsyncTimestampInNs);
+    auto frameStartTime = std::chrono::system_clock::now().time_since_epoch() - timeSinceFrameStart;
+    auto frameStartTimeInMs = std::chrono::duration_cast<std::chrono::milliseconds>(frameStartTime).count();
+    callJSTimers("callIdleCallbacks", folly::dynamic::array(frameStartTimeInMs));
+}
+
+void TimingTurboModule::callJSTimers(std::string &&methodName, folly::dynamic &&args) {
+    if (auto instance = m_ctx.instance.lock()) {
+        instance->callJSFunction("JSTimers", std::move(methodName), std::move(args));
+    }
+}
+
+} // namespace rnoh
@@ -1,12 +1,65 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <folly/dynamic.h>
+#include "RNOH/AppLifecycleListener.h"
 #include "RNOH/ArkTSTurboModule.h"
 
 namespace rnoh {
 
-class JSI_EXPORT TimingTurboModule : public ArkTSTurboModule {
+/**
+ * Runs JS timers on the JS thread, in the JS task runner's timer wheel. Timers that fire together are passed to
+ * `JSTimers.callTimers` in one call. All methods, except the frame listener, are called on the JS thread.
+ */
+class JSI_EXPORT TimingTurboModule : public ArkTSTurboModule,
+                                     public AppLifecycleListener,
+                                     public std::enable_shared_from_this<TimingTurboModule> {
   public:
+    using JSTimerId = int64_t;
+
     TimingTurboModule(const ArkTSTurboModule::Context ctx, const std::string name);
+    ~TimingTurboModule() override;
+
+    void createTimer(JSTimerId id, double durationInMs, double jsSchedulingTime, bool repeats);
+    void deleteTimer(JSTimerId id);
+    void setSendIdleEvents(bool enabled);
+
+    /**
+     * Timers that fire while paused are called once `resume` is called. The module starts paused if it's created while
+     * the app is in background (TurboModuleProvider calls `onBackground`).
+     */
+    void pause();
+    void resume();
+
+    void onForeground() override;
+    void onBackground() override;
+
+  private:
+    struct Timer {
+        TimerId delayedTaskId;
+        std::chrono::steady_clock::time_point deadline;
+        std::chrono::milliseconds duration;
+        bool repeats;
+    };
+
+    void scheduleTimer(JSTimerId id, Timer &timer, std::chrono::steady_clock::time_point deadline);
+    void onTimerFired(JSTimerId id);
+    void callTimers(std::vector<JSTimerId> const &ids);
+    void callIdleCallbacks(FrameInfo const &frameInfo);
+    void callJSTimers(std::string &&methodName, folly::dynamic &&args);
+
+    std::unordered_map<JSTimerId, Timer> m_timerById;
+    std::vector<JSTimerId> m_firedTimerIds;
+    std::vector<JSTimerId> m_timerIdsFiredWhilePaused;
+    bool m_isPaused = false;
+    std::function<void()> m_unsubscribeFromFrames;
+    // NOTE: set on the vsync thread, so idle callbacks don't pile up while the JS thread is busy
+    std::atomic_bool m_isIdleCallbackPending{false};
 };
 
-} // namespace rnoh
\ No newline at end of file
+} // namespace rnoh
@@ -0,0 +1,95 @@
+/**
+ * Measures how fast 1-8 producer threads can hand tasks over to a single consumer, comparing:
+ * - "mutex": std::queue<std::function> behind a mutex, the queue task runners used before TaskQueue,
+ * - "task queue": TaskQueue (MPSCRingBuffer + overflow deque), as used by the task runners.
+ *
+ * Usage: task_queue_benchmark [tasksPerProducer]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RNOH/TaskExecutor/TaskQueue.h"
+
+using namespace rnoh;
+
+namespace {
+
+class MutexQueue {
+  public:
+    void push(std::function<void()> &&task) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push(std::move(task));
+    }
+
+    bool tryPop(std::function<void()> &task) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_tasks.empty()) {
+            return false;
+        }
+        task = std::move(m_tasks.front());
+        m_tasks.pop();
+        return true;
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::queue<std::function<void()>> m_tasks;
+};
+
+/**
+ * Returns the average time from the first push until the consumer has run the last task, in nanoseconds per task.
+ */
+template <typename Queue, typename Task>
+double run(size_t producersCount, size_t tasksPerProducer) {
+    Queue queue;
+    size_t counter = 0;
+    auto tasksCount = producersCount * tasksPerProducer;
+    auto startedAt = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < producersCount; i++) {
+        producers.emplace_back([&queue, &counter, tasksPerProducer] {
+            for (size_t j = 0; j < tasksPerProducer; j++) {
+                // NOTE: only the consumer runs tasks, so `counter` needs no synchronization
+                queue.push(Task([&counter] { counter++; }));
+            }
+        });
+    }
+    Task task;
+    size_t poppedTasksCount = 0;
+    while (poppedTasksCount < tasksCount) {
+        if (queue.tryPop(task)) {
+            task();
+            poppedTasksCount++;
+        }
+    }
+    auto duration = std::chrono::steady_clock::now() - startedAt;
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    if (counter != tasksCount) {
+        std::fprintf(stderr, "lost tasks: %zu of %zu ran\n", counter, tasksCount);
+        std::exit(1);
+    }
+    return std::chrono::duration<double, std::nano>(duration).count() / tasksCount;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    size_t tasksPerProducer = argc > 1 ? std::stoul(argv[1]) : 200'000;
+    std::printf("%-10s %12s %12s   (ns/task, %zu tasks per producer)\n", "producers", "mutex", "task queue",
+                tasksPerProducer);
+    for (size_t producersCount : {1, 2, 4, 8}) {
+        auto mutexResult = run<MutexQueue, std::function<void()>>(producersCount, tasksPerProducer);
+        auto taskQueueResult = run<TaskQueue, UniqueTask>(producersCount, tasksPerProducer);
+        std::printf("%-10zu %12.1f %12.1f\n", producersCount, mutexResult, taskQueueResult);
+    }
+    return 0;
+}
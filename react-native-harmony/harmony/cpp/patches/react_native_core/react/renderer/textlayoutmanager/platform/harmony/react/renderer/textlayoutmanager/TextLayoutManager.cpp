@@ -19,9 +19,9 @@ TextMeasurement TextLayoutManager::measure(
     ParagraphAttributes paragraphAttributes,
     LayoutConstraints layoutConstraints) const {
     auto &attributedString = attributedStringBox.getValue();
-    return m_measureCache.get(
+    return m_measureCache->get(
         {attributedString, paragraphAttributes, layoutConstraints},
-        [&](TextMeasureCacheKey const & /*key*/) {
+        [&] {
             return m_textLayoutManagerDelegate->measure(attributedString, paragraphAttributes, layoutConstraints);
         });
 }
@@ -31,21 +31,29 @@ TextMeasurement TextLayoutManager::measure(
     ParagraphAttributes paragraphAttributes,
     LayoutConstraints layoutConstraints,
     std::shared_ptr<void> hostTextStorage) const {
-    return this->measure(attributedStringBox, paragraphAttributes, layoutConstraints);
+    if (hostTextStorage == nullptr) {
+        return this->measure(attributedStringBox, paragraphAttributes, layoutConstraints);
+    }
+    auto &attributedString = attributedStringBox.getValue();
+    return m_measureCache->get(
+        {attributedString, paragraphAttributes, layoutConstraints},
+        [&] {
+            return m_textLayoutManagerDelegate->measure(attributedString, paragraphAttributes, layoutConstraints, hostTextStorage);
+        });
 }
 
 LinesMeasurements TextLayoutManager::measureLines(
     AttributedString attributedString,
     ParagraphAttributes paragraphAttributes,
     Size size) const {
-    return {};
+    return m_textLayoutManagerDelegate->measureLines(attributedString, paragraphAttributes, size);
 }
 
 std::shared_ptr<void> TextLayoutManager::getHostTextStorage(
     AttributedString attributedString,
     ParagraphAttributes paragraphAttributes,
     LayoutConstraints layoutConstraints) const {
-    return nullptr;
+    return m_textLayoutManagerDelegate->getHostTextStorage(attributedString, paragraphAttributes, layoutConstraints);
 }
 
 } // namespace react
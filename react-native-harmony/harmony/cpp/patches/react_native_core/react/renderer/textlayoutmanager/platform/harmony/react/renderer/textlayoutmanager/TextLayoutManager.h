@@ -14,8 +14,8 @@
 #include <react/renderer/attributedstring/ParagraphAttributes.h>
 #include <react/renderer/core/LayoutConstraints.h>
 #include <react/renderer/textlayoutmanager/TextMeasureCache.h>
+#include <react/renderer/textlayoutmanager/TextMeasurementCache.h>
 #include <react/utils/ContextContainer.h>
-#include <react/renderer/core/CoreFeatures.h>
 
 namespace facebook {
 namespace react {
@@ -29,6 +29,25 @@ class TextLayoutManagerDelegate {
     virtual TextMeasurement measure(AttributedString attributedString,
                                     ParagraphAttributes paragraphAttributes,
                                     LayoutConstraints layoutConstraints) = 0;
+
+    virtual TextMeasurement measure(AttributedString attributedString,
+                                    ParagraphAttributes paragraphAttributes,
+                                    LayoutConstraints layoutConstraints,
+                                    std::shared_ptr<void> hostTextStorage) {
+        return measure(std::move(attributedString), std::move(paragraphAttributes), std::move(layoutConstraints));
+    }
+
+    virtual LinesMeasurements measureLines(AttributedString attributedString,
+                                           ParagraphAttributes paragraphAttributes,
+                                           Size size) {
+        return {};
+    }
+
+    virtual std::shared_ptr<void> getHostTextStorage(AttributedString attributedString,
+                                                     ParagraphAttributes paragraphAttributes,
+                                                     LayoutConstraints layoutConstraints) {
+        return nullptr;
+    }
 };
 
 /*
@@ -36,10 +55,10 @@ class TextLayoutManagerDelegate {
  */
 class TextLayoutManager {
   public:
-    TextLayoutManager(const ContextContainer::Shared &contextContainer) : m_measureCache(CoreFeatures::cacheLastTextMeasurement
-                                                                                             ? 8096
-                                                                                             : kSimpleThreadSafeCacheSizeCap) {
+    TextLayoutManager(const ContextContainer::Shared &contextContainer) {
         m_textLayoutManagerDelegate = contextContainer->at<std::shared_ptr<TextLayoutManagerDelegate>>("textLayoutManagerDelegate");
+        auto measureCache = contextContainer->find<TextMeasurementCache::Shared>("textMeasurementCache");
+        m_measureCache = measureCache.has_value() ? measureCache.value() : std::make_shared<TextMeasurementCache>();
     }
 
     /*
@@ -78,7 +97,7 @@ class TextLayoutManager {
 
   private:
     std::shared_ptr<TextLayoutManagerDelegate> m_textLayoutManagerDelegate;
-    TextMeasureCache m_measureCache;
+    TextMeasurementCache::Shared m_measureCache;
 };
 
 } // namespace react
@@ -0,0 +1,124 @@
+#include "TextMeasurementCache.h"
+
+#include <cmath>
+#include <folly/Hash.h>
+
+namespace facebook {
+namespace react {
+
+// NOTE: wider constraints can't be distinguished from unconstrained ones in practice
+static constexpr float MAX_BUCKETED_WIDTH = 1e9;
+// NOTE: bucketed widths are never negative, so they can't collide with this one
+static constexpr int64_t UNBOUNDED_WIDTH_BUCKET = -1;
+
+TextMeasurement TextMeasurementCache::get(TextMeasureCacheKey const &key, std::function<TextMeasurement()> const &measure) {
+    auto hash = hashKey(key);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto it = find(hash, key); it != m_entries.end()) {
+            m_hitsCount++;
+            m_entries.splice(m_entries.begin(), m_entries, it);
+            return it->measurement;
+        }
+        m_missesCount++;
+    }
+
+    auto measurement = measure();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // NOTE: the same key could have been measured on another thread in the meantime
+    if (auto it = find(hash, key); it != m_entries.end()) {
+        return measurement;
+    }
+    auto sizeInBytes = estimateSizeInBytes(key, measurement);
+    if (sizeInBytes > m_budgetInBytes) {
+        return measurement;
+    }
+    trimTo(m_budgetInBytes - sizeInBytes);
+    m_entries.push_front({hash, key, measurement, sizeInBytes});
+    m_entryItsByHash.emplace(hash, m_entries.begin());
+    m_sizeInBytes += sizeInBytes;
+    return measurement;
+}
+
+void TextMeasurementCache::onMemoryLevel(size_t memoryLevel) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (memoryLevel == 0) {
+        m_budgetInBytes = m_maxSizeInBytes;
+    } else if (memoryLevel == 1) {
+        m_budgetInBytes = m_maxSizeInBytes / 4;
+    } else {
+        m_budgetInBytes = 0;
+    }
+    trimTo(m_budgetInBytes);
+}
+
+void TextMeasurementCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    trimTo(0);
+}
+
+TextMeasurementCache::Stats TextMeasurementCache::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return {
+        .hitsCount = m_hitsCount,
+        .missesCount = m_missesCount,
+        .evictionsCount = m_evictionsCount,
+        .entriesCount = m_entries.size(),
+        .sizeInBytes = m_sizeInBytes,
+        .maxSizeInBytes = m_maxSizeInBytes,
+    };
+}
+
+size_t TextMeasurementCache::hashKey(TextMeasureCacheKey const &key) {
+    // NOTE: widths are bucketed to whole points, equal constraints always fall into the same bucket. Infinite widths
+    // (Yoga's undefined measure mode), NaN and out-of-range widths can't be converted to an integer, so they share a
+    // sentinel bucket.
+    auto width = key.layoutConstraints.maximumSize.width;
+    auto widthBucket = std::isfinite(width) && width >= 0 && width < MAX_BUCKETED_WIDTH
+        ? static_cast<int64_t>(std::floor(width))
+        : UNBOUNDED_WIDTH_BUCKET;
+    return folly::hash::hash_combine(
+        0,
+        textAttributedStringHashLayoutWise(key.attributedString),
+        key.paragraphAttributes,
+        widthBucket);
+}
+
+size_t TextMeasurementCache::estimateSizeInBytes(TextMeasureCacheKey const &key, TextMeasurement const &measurement) {
+    auto result = sizeof(Entry) + 2 * sizeof(void *) /* list node */ + sizeof(std::pair<size_t, EntryIt>) + 2 * sizeof(void *) /* map node */;
+    for (auto const &fragment : key.attributedString.getFragments()) {
+        result += sizeof(AttributedString::Fragment) + fragment.string.capacity() + fragment.textAttributes.fontFamily.capacity();
+    }
+    result += measurement.attachments.capacity() * sizeof(TextMeasurement::Attachment);
+    return result;
+}
+
+TextMeasurementCache::EntryIt TextMeasurementCache::find(size_t hash, TextMeasureCacheKey const &key) {
+    auto [begin, end] = m_entryItsByHash.equal_range(hash);
+    for (auto it = begin; it != end; it++) {
+        if (it->second->key == key) {
+            return it->second;
+        }
+    }
+    return m_entries.end();
+}
+
+void TextMeasurementCache::trimTo(size_t sizeInBytes) {
+    while (m_sizeInBytes > sizeInBytes && !m_entries.empty()) {
+        auto &entry = m_entries.back();
+        auto [begin, end] = m_entryItsByHash.equal_range(entry.hash);
+        for (auto it = begin; it != end; it++) {
+            if (&*it->second == &entry) {
+                m_entryItsByHash.erase(it);
+                break;
+            }
+        }
+        m_sizeInBytes -= entry.sizeInBytes;
+        m_evictionsCount++;
+        m_entries.pop_back();
+    }
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <react/renderer/textlayoutmanager/TextMeasureCache.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Thread-safe LRU cache of text measurements, bounded by the estimated number of bytes used by its entries rather than
+ * by the number of entries. It's shared by all TextLayoutManagers of an RNInstance (via the ContextContainer), so it
+ * can be trimmed when the system is low on memory.
+ */
+class TextMeasurementCache {
+  public:
+    using Shared = std::shared_ptr<TextMeasurementCache>;
+
+    static constexpr size_t DEFAULT_MAX_SIZE_IN_BYTES = 2 * 1024 * 1024;
+
+    struct Stats {
+        size_t hitsCount;
+        size_t missesCount;
+        size_t evictionsCount;
+        size_t entriesCount;
+        size_t sizeInBytes;
+        size_t maxSizeInBytes;
+    };
+
+    TextMeasurementCache(size_t maxSizeInBytes = DEFAULT_MAX_SIZE_IN_BYTES)
+        : m_maxSizeInBytes(maxSizeInBytes), m_budgetInBytes(maxSizeInBytes) {}
+
+    /*
+     * Returns the cached measurement or calls `measure` (without holding the lock) and caches its result.
+     */
+    TextMeasurement get(TextMeasureCacheKey const &key, std::function<TextMeasurement()> const &measure);
+
+    /*
+     * Handles OH memory levels: 0 - moderate, 1 - low, 2 - critical. Low and critical levels trim the cache and keep
+     * its budget reduced (to a quarter and to zero) until the moderate level is reported again.
+     */
+    void onMemoryLevel(size_t memoryLevel);
+
+    void clear();
+
+    Stats getStats() const;
+
+  private:
+    struct Entry {
+        size_t hash;
+        TextMeasureCacheKey key;
+        TextMeasurement measurement;
+        size_t sizeInBytes;
+    };
+
+    using EntryIt = std::list<Entry>::iterator;
+
+    static size_t hashKey(TextMeasureCacheKey const &key);
+    static size_t estimateSizeInBytes(TextMeasureCacheKey const &key, TextMeasurement const &measurement);
+
+    EntryIt find(size_t hash, TextMeasureCacheKey const &key);
+    void trimTo(size_t sizeInBytes);
+
+    mutable std::mutex m_mutex;
+    // NOTE: the most recently used entries are at the front
+    std::list<Entry> m_entries;
+    std::unordered_multimap<size_t, EntryIt> m_entryItsByHash;
+    size_t m_sizeInBytes = 0;
+    size_t m_maxSizeInBytes;
+    // NOTE: lower than m_maxSizeInBytes while the system is low on memory
+    size_t m_budgetInBytes;
+    size_t m_hitsCount = 0;
+    size_t m_missesCount = 0;
+    size_t m_evictionsCount = 0;
+};
+
+} // namespace react
+} // namespace facebook
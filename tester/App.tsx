@@ -17,7 +17,13 @@ import {
   NestedScrollingExample,
 } from './examples';
 import {NavigationContainer, Page} from './components';
-import {Benchmarker, DeepTree, SierpinskiTriangle} from './benchmarks';
+import {
+  Benchmarker,
+  DeepTree,
+  ShortTexts,
+  SierpinskiTriangle,
+  TurboModuleRoundTrip,
+} from './benchmarks';
 import {PortalHost, PortalProvider} from '@gorhom/portal';
 import * as tests from './tests';
 import {Tester} from '@rnoh/testerino';
@@ -95,6 +101,17 @@ function App() {
             )}
           />
         </Page>
+        <Page name="BENCHMARK: MEASURING 10K SHORT TEXTS">
+          <Benchmarker
+            samplesCount={10}
+            renderContent={refreshKey => (
+              <ShortTexts count={10000} seed={refreshKey} />
+            )}
+          />
+        </Page>
+        <Page name="BENCHMARK: TURBOMODULE ROUND TRIP (1 KB / 100 KB / 1 MB)">
+          <TurboModuleRoundTrip />
+        </Page>
         <Page name="EXAMPLE: ANIMATIONS">
           <AnimationsExample />
         </Page>
@@ -0,0 +1,32 @@
+import React from 'react';
+import {StyleSheet, Text, View} from 'react-native';
+
+/**
+ * Renders `count` short, single-fragment texts. Each of them has to be measured natively, so this benchmark is
+ * dominated by the text measurement cost. `seed` changes the content, which bypasses the measure cache.
+ */
+export function ShortTexts({count, seed}: {count: number; seed: number}) {
+  return (
+    <View style={styles.container}>
+      {Array.from({length: count}).map((_, i) => (
+        <Text key={i} style={i % 2 === 0 ? styles.text : styles.boldText}>
+          {(i * 7919 + seed) % 100000}
+        </Text>
+      ))}
+    </View>
+  );
+}
+
+const styles = StyleSheet.create({
+  container: {
+    flexDirection: 'row',
+    flexWrap: 'wrap',
+  },
+  text: {
+    fontSize: 8,
+  },
+  boldText: {
+    fontSize: 10,
+    fontWeight: 'bold',
+  },
+});
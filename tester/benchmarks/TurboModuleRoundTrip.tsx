@@ -0,0 +1,101 @@
+import {useState} from 'react';
+import {Text, TouchableOpacity, TurboModuleRegistry, View} from 'react-native';
+import type {TurboModule} from 'react-native/Libraries/TurboModule/RCTExport';
+
+interface Spec extends TurboModule {
+  getObject(arg: Object): Object;
+}
+
+const SampleTurboModule = TurboModuleRegistry.get<Spec>('SampleTurboModule')!;
+
+const PAYLOADS = [
+  {name: '1 KB', sizeInBytes: 1024, callsCount: 1000},
+  {name: '100 KB', sizeInBytes: 100 * 1024, callsCount: 100},
+  {name: '1 MB', sizeInBytes: 1024 * 1024, callsCount: 10},
+];
+
+type Result = {name: string; callsCount: number; msPerCall: number};
+
+/**
+ * Builds an object resembling typical JSON data (records with numbers, strings and arrays) whose JSON representation
+ * takes about `sizeInBytes`.
+ */
+function createPayload(sizeInBytes: number) {
+  const items = [];
+  let payloadSizeInBytes = 0;
+  for (let i = 0; payloadSizeInBytes < sizeInBytes; i++) {
+    const item = {
+      id: i,
+      name: `item-${i}`,
+      value: i * 0.5,
+      isEnabled: i % 2 === 0,
+      tags: ['a', 'b', 'c'],
+    };
+    items.push(item);
+    payloadSizeInBytes += JSON.stringify(item).length + 1;
+  }
+  return {items};
+}
+
+/**
+ * Round-trips payloads of different sizes through a synchronous ArkTS TurboModule call, which converts the argument
+ * from JSI to napi and the result back.
+ */
+export function TurboModuleRoundTrip() {
+  const [results, setResults] = useState<Result[]>([]);
+  const [status, setStatus] = useState<'READY' | 'RUNNING' | 'FINISHED'>(
+    'READY',
+  );
+
+  function start() {
+    setStatus('RUNNING');
+    setResults([]);
+    // NOTE: lets the "Running..." label render before the JS thread gets blocked
+    setTimeout(() => {
+      const newResults: Result[] = [];
+      for (const {name, sizeInBytes, callsCount} of PAYLOADS) {
+        const payload = createPayload(sizeInBytes);
+        // NOTE: warm-up
+        SampleTurboModule.getObject(payload);
+        const startTime = Date.now();
+        for (let i = 0; i < callsCount; i++) {
+          const result = SampleTurboModule.getObject(payload) as {
+            items: unknown[];
+          };
+          if (result.items.length !== payload.items.length) {
+            throw new Error(`${name} payload changed during the round trip`);
+          }
+        }
+        newResults.push({
+          name,
+          callsCount,
+          msPerCall: (Date.now() - startTime) / callsCount,
+        });
+      }
+      setResults(newResults);
+      setStatus('FINISHED');
+    }, 0);
+  }
+
+  return (
+    <View style={{height: '100%', padding: 16}}>
+      <TouchableOpacity onPress={start} disabled={status === 'RUNNING'}>
+        <Text
+          style={{
+            width: 200,
+            height: 32,
+            fontWeight: 'bold',
+            color: status !== 'RUNNING' ? 'blue' : 'black',
+          }}>
+          {status === 'RUNNING' ? 'Running...' : 'Start'}
+        </Text>
+      </TouchableOpacity>
+      {results.map(result => (
+        <Text key={result.name} style={{height: 24}}>
+          {result.name}: {result.msPerCall.toFixed(3)} ms per call (
+          {result.callsCount} calls)
+        </Text>
+      ))}
+    </View>
+  );
+}
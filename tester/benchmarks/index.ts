@@ -1,3 +1,5 @@
 export * from './DeepTree';
 export * from './Benchmarker';
 export * from './SierpinskiTriangle';
+export * from './ShortTexts';
+export * from './TurboModuleRoundTrip';
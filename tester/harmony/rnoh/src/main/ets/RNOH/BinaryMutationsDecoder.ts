@@ -0,0 +1,204 @@
+import util from '@ohos.util';
+import type { Descriptor } from './DescriptorBase'
+import type { Mutation } from './Mutation'
+import { MutationType } from './Mutation'
+import { defineLazyRawProps } from './LazyRawProps'
+
+/**
+ * Must be kept in sync with BinaryMutationsSerializer.h
+ */
+const MAGIC = 0x424D4E52
+const VERSION = 2
+const HEADER_SIZE = 24
+const RECORD_SIZE = 56
+const NO_VALUE = 0xFFFFFFFF
+const HAS_NAPI_BINDER_FLAG = 1 << 0
+const LAYOUT_METRICS_UNCHANGED_FLAG = 1 << 1
+const HAS_REMOVED_PROPS_FLAG = 1 << 2
+
+enum ValueType {
+  NULL_VALUE = 0,
+  FALSE_VALUE = 1,
+  TRUE_VALUE = 2,
+  NUMBER = 3,
+  STRING = 4,
+  ARRAY = 5,
+  OBJECT = 6,
+}
+
+type NapiBinderPayload = [Object, Object]
+
+/**
+ * Decodes mutations produced by BinaryMutationsSerializer. Records are read directly from the buffer,
+ * strings are decoded once per buffer and only when used, and rawProps are decoded on first access. The nativeID is
+ * stored in the record, so DescriptorRegistry can index descriptors without accessing rawProps.
+ */
+export class BinaryMutationsDecoder {
+  private textDecoder = util.TextDecoder.create("utf-8")
+
+  public decode(buffer: ArrayBuffer, napiBinderPayloads: NapiBinderPayload[]): Mutation[] {
+    const view = new DataView(buffer)
+    if (view.getUint32(0, true) !== MAGIC || view.getUint16(4, true) !== VERSION) {
+      throw new Error("Unsupported binary mutations format")
+    }
+    const mutationsCount = view.getUint32(8, true)
+    const strings = new StringTableReader(buffer, view, view.getUint32(12, true), view.getUint32(16, true), this.textDecoder)
+    const valuesOffset = view.getUint32(20, true)
+    const mutations: Mutation[] = new Array(mutationsCount)
+    let napiBinderPayloadIdx = 0
+    for (let i = 0; i < mutationsCount; i++) {
+      const offset = HEADER_SIZE + i * RECORD_SIZE
+      const type: MutationType = view.getUint8(offset)
+      const tag = view.getInt32(offset + 4, true)
+      switch (type) {
+        case MutationType.CREATE:
+        case MutationType.UPDATE: {
+          const flags = view.getUint16(offset + 2, true)
+          const napiBinderPayload = (flags & HAS_NAPI_BINDER_FLAG) ? napiBinderPayloads[napiBinderPayloadIdx++] : undefined
+          const descriptor = this.decodeDescriptor(view, offset, tag, flags, strings, valuesOffset, napiBinderPayload)
+          if (type === MutationType.UPDATE && (flags & HAS_REMOVED_PROPS_FLAG)) {
+            const valueReader = new ValueReader(view, strings, valuesOffset + view.getUint32(offset + 20, true))
+            descriptor.rawProps = valueReader.read()
+            mutations[i] = { type, descriptor, removedRawPropNames: valueReader.read() }
+          } else {
+            mutations[i] = { type, descriptor } as Mutation
+          }
+          break
+        }
+        case MutationType.INSERT:
+          mutations[i] = {
+            type,
+            childTag: tag,
+            parentTag: view.getInt32(offset + 8, true),
+            index: view.getInt32(offset + 12, true)
+          }
+          break
+        case MutationType.REMOVE:
+          mutations[i] = { type, childTag: tag, parentTag: view.getInt32(offset + 8, true) }
+          break
+        case MutationType.DELETE:
+          mutations[i] = { type, tag }
+          break
+        default:
+          mutations[i] = { type: MutationType.REMOVE_DELETE_TREE }
+      }
+    }
+    return mutations
+  }
+
+  private decodeDescriptor(
+    view: DataView,
+    offset: number,
+    tag: number,
+    flags: number,
+    strings: StringTableReader,
+    valuesOffset: number,
+    napiBinderPayload: NapiBinderPayload | undefined
+  ): Descriptor {
+    const propsOffset = view.getUint32(offset + 20, true)
+    const nativeIdId = view.getUint32(offset + 12, true)
+    const descriptor = {
+      tag,
+      type: strings.get(view.getUint32(offset + 16, true)),
+      nativeId: nativeIdId === NO_VALUE ? null : strings.get(nativeIdId),
+      isDynamicBinder: napiBinderPayload === undefined,
+      props: napiBinderPayload?.[0] ?? {},
+      state: napiBinderPayload?.[1] ?? {},
+      childrenTags: [],
+    } as Descriptor
+    if (!(flags & LAYOUT_METRICS_UNCHANGED_FLAG)) {
+      descriptor.layoutMetrics = {
+        frame: {
+          origin: {
+            x: view.getFloat64(offset + 24, true),
+            y: view.getFloat64(offset + 32, true),
+          },
+          size: {
+            width: view.getFloat64(offset + 40, true),
+            height: view.getFloat64(offset + 48, true),
+          }
+        },
+        layoutDirection: view.getUint8(offset + 1),
+      }
+    }
+    defineLazyRawProps(descriptor, () => {
+      return propsOffset === NO_VALUE ? {} : new ValueReader(view, strings, valuesOffset + propsOffset).read()
+    })
+    return descriptor
+  }
+}
+
+class StringTableReader {
+  private stringOffsets: number[] = []
+  private decodedStrings: (string | undefined)[]
+
+  constructor(private buffer: ArrayBuffer, private view: DataView, stringsCount: number, stringsOffset: number, private textDecoder: util.TextDecoder) {
+    this.decodedStrings = new Array(stringsCount)
+    let offset = stringsOffset
+    for (let i = 0; i < stringsCount; i++) {
+      this.stringOffsets.push(offset)
+      offset += 4 + view.getUint32(offset, true)
+    }
+  }
+
+  public get(id: number): string {
+    let result = this.decodedStrings[id]
+    if (result === undefined) {
+      const offset = this.stringOffsets[id]
+      const byteLength = this.view.getUint32(offset, true)
+      result = this.textDecoder.decodeWithStream(new Uint8Array(this.buffer, offset + 4, byteLength))
+      this.decodedStrings[id] = result
+    }
+    return result
+  }
+}
+
+class ValueReader {
+  constructor(private view: DataView, private strings: StringTableReader, private offset: number) {
+  }
+
+  public read(): any {
+    const type: ValueType = this.view.getUint8(this.offset)
+    this.offset += 1
+    switch (type) {
+      case ValueType.NULL_VALUE:
+        return null
+      case ValueType.FALSE_VALUE:
+        return false
+      case ValueType.TRUE_VALUE:
+        return true
+      case ValueType.NUMBER: {
+        const value = this.view.getFloat64(this.offset, true)
+        this.offset += 8
+        return value
+      }
+      case ValueType.STRING:
+        return this.strings.get(this.readUint32())
+      case ValueType.ARRAY: {
+        const length = this.readUint32()
+        const result = new Array(length)
+        for (let i = 0; i < length; i++) {
+          result[i] = this.read()
+        }
+        return result
+      }
+      case ValueType.OBJECT: {
+        const size = this.readUint32()
+        const result = {}
+        for (let i = 0; i < size; i++) {
+          const key = this.strings.get(this.readUint32())
+          result[key] = this.read()
+        }
+        return result
+      }
+      default:
+        throw new Error(`Unknown value type: ${type}`)
+    }
+  }
+
+  private readUint32(): number {
+    const value = this.view.getUint32(this.offset, true)
+    this.offset += 4
+    return value
+  }
+}
@@ -73,13 +73,13 @@ TState extends StateBase = StateBase, TRawProps extends RawPropsBase = RawPropsB
   }
 
   public get id(): NativeId | undefined {
-    const rawId = this.rawProps.nativeID
+    const rawId = this.rawNativeId
     if (rawId?.startsWith("__harmony::")) {
       const cheatcodeAndId = rawId.replace("__harmony::", "")
       const [_cheatcodes, actualId] = cheatcodeAndId.split(":")
       return actualId
     }
-    return this.rawProps.nativeID
+    return rawId
   }
 
   /**
@@ -90,7 +90,7 @@ TState extends StateBase = StateBase, TRawProps extends RawPropsBase = RawPropsB
    * ```
    */
   public get hints(): string[] {
-    const rawId = this.rawProps.nativeID
+    const rawId = this.rawNativeId
     if (rawId?.startsWith("__harmony::")) {
       const hintsAndId = rawId.replace("__harmony::", "")
       const [hints, _actualId] = hintsAndId.split(":")
@@ -103,6 +103,13 @@ TState extends StateBase = StateBase, TRawProps extends RawPropsBase = RawPropsB
     return this.descriptor.rawProps
   }
 
+  private get rawNativeId(): NativeId | undefined {
+    if (this.descriptor.nativeId !== undefined) {
+      return this.descriptor.nativeId ?? undefined
+    }
+    return this.rawProps.nativeID
+  }
+
   protected get props(): TProps | Object {
     if (this.descriptor.isDynamicBinder) {
       return {}
@@ -174,6 +181,11 @@ TRawProps extends Object = Object> {
   props: TProps;
   state: TState;
   rawProps: TRawProps;
+  /**
+   * `rawProps.nativeID`, provided separately so that the descriptor can be indexed without decoding `rawProps`.
+   * `null` if there is no nativeID, `undefined` if it is only available in `rawProps`.
+   */
+  nativeId?: NativeId | null;
   childrenTags: Tag[];
   layoutMetrics: LayoutMetrics;
 
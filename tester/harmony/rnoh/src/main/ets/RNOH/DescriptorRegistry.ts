@@ -1,6 +1,7 @@
 import { Tag, Descriptor, NativeId, DescriptorWrapper } from './DescriptorBase';
 import { Mutation } from './Mutation';
 import { MutationType } from './Mutation';
+import { copyWithoutRawProps, defineMergedRawProps } from './LazyRawProps';
 import type { RNInstanceImpl } from './RNInstance'
 import type { RNOHLogger } from './RNOHLogger'
 
@@ -267,14 +268,30 @@ export class DescriptorRegistry {
       const mutationDescriptor = this.maybeOverwriteProps(mutation.descriptor)
       const animatedProps = this.animatedRawPropsByTag.get(mutation.descriptor.tag);
 
+      const removedRawPropNames = mutation.removedRawPropNames ?? []
+
+      const props = { ...currentDescriptor!.props, ...mutationDescriptor.props }
+      if (mutationDescriptor.isDynamicBinder) {
+        for (const propName of removedRawPropNames) {
+          delete props[propName]
+        }
+      }
+
+      // NOTE: rawProps are merged on first access, so they aren't decoded if no component reads them
       const newDescriptor = {
-        ...currentDescriptor,
-        ...mutation.descriptor,
+        ...copyWithoutRawProps(currentDescriptor!),
+        ...copyWithoutRawProps(mutationDescriptor),
         // NOTE: animated props override the ones from the mutation
-        props: { ...currentDescriptor!.props, ...mutationDescriptor.props, ...animatedProps },
-        rawProps: { ...currentDescriptor!.rawProps, ...mutationDescriptor.rawProps, ...animatedProps },
+        props: { ...props, ...animatedProps },
         childrenTags: children,
-      };
+      } as Descriptor;
+      defineMergedRawProps(newDescriptor, [currentDescriptor!, mutationDescriptor], () => {
+        const rawProps = { ...currentDescriptor!.rawProps, ...mutationDescriptor.rawProps }
+        for (const propName of removedRawPropNames) {
+          delete rawProps[propName]
+        }
+        return { ...rawProps, ...animatedProps }
+      })
       this.saveDescriptor(newDescriptor)
       return [mutation.descriptor.tag];
     } else if (mutation.type === MutationType.REMOVE) {
@@ -302,9 +319,13 @@ export class DescriptorRegistry {
      * didn't provided explicit NapiBinder and props were generated from rawProps. Currently, however descriptors have
      * rawProps property which can be used instead. `isDynamicBinder` and this change is going to be removed in the
      * future.
+     *
+     * NOTE: the descriptor is updated in place, because spreading it would decode lazily decoded rawProps.
      */
-    const props = descriptor.isDynamicBinder ? descriptor.rawProps : descriptor.props
-    return { ...descriptor, props }
+    if (descriptor.isDynamicBinder) {
+      descriptor.props = descriptor.rawProps
+    }
+    return descriptor
   }
 
   public createRootDescriptor(tag: Tag) {
@@ -1,4 +1,5 @@
 import type resmgr from '@ohos.resourceManager';
+import fs from '@ohos.file.fs';
 import http from '@ohos.net.http';
 import { RNOHLogger } from './RNOHLogger';
 import urlUtils from '@ohos.url';
@@ -25,6 +26,13 @@ export abstract class JSBundleProvider {
   getJSPackagerClientConfig(): JSPackagerClientConfig | null {
     return null;
   }
+
+  /**
+   * Bundles provided as a file are memory-mapped by the native side instead of being read into an ArrayBuffer.
+   */
+  getBundleFilePath(): string | null {
+    return null
+  }
 }
 
 
@@ -60,6 +68,40 @@ export class ResourceJSBundleProvider extends JSBundleProvider {
 }
 
 
+export class FileJSBundleProvider extends JSBundleProvider {
+  constructor(private path: string, private appKeys: string[] = []) {
+    super()
+  }
+
+  getURL() {
+    return this.path
+  }
+
+  getAppKeys() {
+    return this.appKeys
+  }
+
+  getBundleFilePath() {
+    return this.path
+  }
+
+  async getBundle() {
+    try {
+      const file = await fs.open(this.path, fs.OpenMode.READ_ONLY)
+      try {
+        const bundle = new ArrayBuffer((await fs.stat(file.fd)).size)
+        await fs.read(file.fd, bundle)
+        return bundle
+      } finally {
+        await fs.close(file)
+      }
+    } catch (err) {
+      throw new JSBundleProviderError(`Couldn't load JSBundle from ${this.path}`, err)
+    }
+  }
+}
+
+
 export class MetroJSBundleProvider extends JSBundleProvider {
   static fromServerIp(ip: string, port: number = 8081, appKeys: string[] = []): MetroJSBundleProvider {
     return new MetroJSBundleProvider(`http://${ip}:${port}/index.bundle?platform=harmony&dev=true&minify=false`, appKeys)
@@ -204,6 +246,13 @@ export class AnyJSBundleProvider extends JSBundleProvider {
     }
     return null;
   }
+
+  getBundleFilePath(): string | null {
+    if (this.pickedJSBundleProvider) {
+      return this.pickedJSBundleProvider.getBundleFilePath()
+    }
+    return null
+  }
 }
 
 export class TraceJSBundleProviderDecorator extends JSBundleProvider {
@@ -236,4 +285,8 @@ export class TraceJSBundleProviderDecorator extends JSBundleProvider {
   getJSPackagerClientConfig(): JSPackagerClientConfig {
     return this.jsBundleProvider.getJSPackagerClientConfig();
   }
+
+  getBundleFilePath(): string | null {
+    return this.jsBundleProvider.getBundleFilePath()
+  }
 }
\ No newline at end of file
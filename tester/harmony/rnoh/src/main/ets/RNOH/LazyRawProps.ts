@@ -0,0 +1,59 @@
+import type { Descriptor } from './DescriptorBase'
+
+/**
+ * Number of merges waiting for the first `rawProps` access, by descriptor. Each one keeps the previous descriptor (and
+ * the mutations buffer it was decoded from) alive, so the chain is materialized once it gets this long.
+ */
+const MAX_PENDING_RAW_PROPS_MERGES = 8
+const pendingRawPropsMergesCountByDescriptor = new WeakMap<Descriptor, number>()
+
+/**
+ * Defines `descriptor.rawProps`, computed on first access. Spreading the descriptor reads it, use `copyWithoutRawProps`
+ * to keep it lazy.
+ */
+export function defineLazyRawProps(descriptor: Descriptor, computeRawProps: () => Object): void {
+  let rawProps: Object | undefined = undefined
+  Object.defineProperty(descriptor, "rawProps", {
+    enumerable: true,
+    configurable: true,
+    get: () => {
+      if (rawProps === undefined) {
+        rawProps = computeRawProps()
+        pendingRawPropsMergesCountByDescriptor.delete(descriptor)
+      }
+      return rawProps
+    },
+    set: (value: Object) => {
+      rawProps = value
+      pendingRawPropsMergesCountByDescriptor.delete(descriptor)
+    }
+  })
+  pendingRawPropsMergesCountByDescriptor.set(descriptor, 1)
+}
+
+/**
+ * Defines `descriptor.rawProps` as a merge of the rawProps of `baseDescriptors`, computed on first access unless too
+ * many merges are pending already.
+ */
+export function defineMergedRawProps(descriptor: Descriptor, baseDescriptors: Descriptor[],
+  computeRawProps: () => Object): void {
+  const pendingMergesCount = 1 + Math.max(0, ...baseDescriptors.map(baseDescriptor => {
+    return pendingRawPropsMergesCountByDescriptor.get(baseDescriptor) ?? 0
+  }))
+  if (pendingMergesCount > MAX_PENDING_RAW_PROPS_MERGES) {
+    descriptor.rawProps = computeRawProps()
+    return
+  }
+  defineLazyRawProps(descriptor, computeRawProps)
+  pendingRawPropsMergesCountByDescriptor.set(descriptor, pendingMergesCount)
+}
+
+export function copyWithoutRawProps<TDescriptor extends Descriptor>(descriptor: TDescriptor): Omit<TDescriptor, "rawProps"> {
+  const result: Partial<TDescriptor> = {}
+  for (const key of Object.keys(descriptor) as (keyof TDescriptor)[]) {
+    if (key !== "rawProps") {
+      result[key] = descriptor[key]
+    }
+  }
+  return result as Omit<TDescriptor, "rawProps">
+}
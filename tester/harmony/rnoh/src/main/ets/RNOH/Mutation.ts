@@ -53,7 +53,12 @@ export type RemoveMutation = {
 
 export type UpdateMutation = {
   type: MutationType.UPDATE
+  /**
+   * When props diffing is enabled, the descriptor contains only changed (raw)props, and layoutMetrics are
+   * omitted if they didn't change.
+   */
   descriptor: Descriptor
+  removedRawPropNames?: string[]
 }
 
 export type RemoveDeleteTreeMutation = {
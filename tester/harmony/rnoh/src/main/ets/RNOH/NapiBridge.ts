@@ -1,9 +1,15 @@
 import type { TurboModuleProvider } from "./TurboModuleProvider";
 import type { Mutation } from "./Mutation";
 import type { Tag } from "./DescriptorBase";
-import type { AttributedString, ParagraphAttributes, LayoutConstrains } from "./TextLayoutManager";
-import { measureParagraph } from "./TextLayoutManager"
 import type { DisplayMode } from './CppBridgeUtils'
+import type {
+  AnimationTelemetry,
+  HermesHeapInfo,
+  HermesRuntimeConfig,
+  MutationsTransport,
+  TaskLaneStatsByThread,
+  TextMeasurementCacheStats
+} from './RNInstance'
 import { RNOHLogger } from "./RNOHLogger"
 
 export class NapiBridge {
@@ -23,13 +29,17 @@ export class NapiBridge {
 
   createReactNativeInstance(instanceId: number,
                             turboModuleProvider: TurboModuleProvider,
-                            mutationsListener: (mutations: Mutation[]) => void,
+                            mutationsListener: (mutations: Mutation[] | ArrayBuffer, napiBinderPayloads?: [Object, Object][]) => void,
                             componentCommandsListener: (tag: Tag,
                                                         commandName: string,
                                                         args: unknown) => void,
                             onCppMessage: (type: string, payload: any) => void,
-
-
+                            cppOptions: {
+                              mutationsTransport: MutationsTransport,
+                              isPropsDiffingEnabled: boolean,
+                              isAnimationFrameRateThrottlingEnabled: boolean,
+                              hermesRuntimeConfig: HermesRuntimeConfig
+                            },
   ) {
     this.libRNOHApp?.createReactNativeInstance(
       instanceId,
@@ -37,17 +47,7 @@ export class NapiBridge {
       mutationsListener,
       componentCommandsListener,
       onCppMessage,
-      (attributedString: AttributedString, paragraphAttributes: ParagraphAttributes, layoutConstraints: LayoutConstrains) => {
-        try {
-          const stopTracing = this.logger.clone("measureParagraph").startTracing()
-          const result = measureParagraph(attributedString, paragraphAttributes, layoutConstraints)
-          stopTracing()
-          return result
-        } catch (err) {
-          console.error(err)
-          throw err
-        }
-      });
+      cppOptions);
   }
 
   destroyReactNativeInstance(instanceId: number) {
@@ -66,6 +66,22 @@ export class NapiBridge {
     })
   }
 
+  loadScriptFromFile(instanceId: number, bundlePath: string, sourceURL: string): Promise<void> {
+    return new Promise((resolve, reject) => {
+      this.libRNOHApp?.loadScriptFromFile(instanceId, bundlePath, sourceURL, (errorMsg: string) => {
+        errorMsg ? reject(new Error(errorMsg)) : resolve()
+      });
+    })
+  }
+
+  registerSegment(instanceId: number, segmentId: number, segmentPath: string): Promise<void> {
+    return new Promise((resolve, reject) => {
+      this.libRNOHApp?.registerSegment(instanceId, segmentId, segmentPath, (errorMsg: string) => {
+        errorMsg ? reject(new Error(errorMsg)) : resolve()
+      });
+    })
+  }
+
   startSurface(
     instanceId: number,
     surfaceTag: number,
@@ -163,6 +179,34 @@ export class NapiBridge {
     this.libRNOHApp?.onMemoryLevel(level)
   }
 
+  onForeground(instanceId: number): void {
+    this.libRNOHApp?.onForeground(instanceId)
+  }
+
+  onBackground(instanceId: number): void {
+    this.libRNOHApp?.onBackground(instanceId)
+  }
+
+  getTextMeasurementCacheStats(instanceId: number): TextMeasurementCacheStats | undefined {
+    return this.libRNOHApp?.getTextMeasurementCacheStats(instanceId)
+  }
+
+  getTaskLaneStats(instanceId: number): TaskLaneStatsByThread | undefined {
+    return this.libRNOHApp?.getTaskLaneStats(instanceId)
+  }
+
+  getAnimationTelemetry(instanceId: number): AnimationTelemetry[] | undefined {
+    return this.libRNOHApp?.getAnimationTelemetry(instanceId)
+  }
+
+  getHermesHeapInfo(instanceId: number, includeExpensive: boolean): Promise<HermesHeapInfo> {
+    return new Promise((resolve) => {
+      this.libRNOHApp?.getHermesHeapInfo(instanceId, includeExpensive, (heapInfo: HermesHeapInfo) => {
+        resolve(heapInfo)
+      });
+    })
+  }
+
   updateState(instanceId: number, componentName: string, tag: Tag, state: unknown): void {
     this.libRNOHApp?.updateState(instanceId, componentName, tag, state)
   }
@@ -17,6 +17,7 @@ import type { RNPackage, RNPackageContext } from './RNPackage'
 import type { TurboModule } from './TurboModule'
 import { ResponderLockDispatcher } from './ResponderLockDispatcher'
 import { JSPackagerClient } from './JSPackagerClient'
+import { BinaryMutationsDecoder } from './BinaryMutationsDecoder'
 
 export type SurfaceContext = {
   width: number
@@ -68,6 +69,89 @@ const rootDescriptor = {
 
 type FeatureFlagName = "USE_BUILD_RN_COMPONENT" | "ENABLE_RN_INSTANCE_CLEAN_UP"
 
+/**
+ * "OBJECTS" - each mutation is converted to an object on the C++ side
+ * "BINARY" - mutations are encoded off the main thread into a single ArrayBuffer and decoded lazily on the ArkTS side
+ */
+export type MutationsTransport = "OBJECTS" | "BINARY"
+
+export type TextMeasurementCacheStats = {
+  hitsCount: number,
+  missesCount: number,
+  evictionsCount: number,
+  entriesCount: number,
+  sizeInBytes: number,
+  maxSizeInBytes: number,
+}
+
+export type TaskLaneStats = {
+  queueDepth: number,
+  /**
+   * Bucket 0 counts zeros, bucket i counts values in [2^(i-1), 2^i).
+   */
+  queueDepthHistogram: number[],
+  waitTimeInUsHistogram: number[],
+}
+
+export type TaskLaneName = "INPUT" | "ANIMATION" | "MOUNT" | "NORMAL" | "IDLE"
+
+export type TaskLaneStatsByThread = {
+  MAIN: Record<TaskLaneName, TaskLaneStats>,
+  JS: Record<TaskLaneName, TaskLaneStats>,
+}
+
+export type AnimationTelemetry = {
+  animationId: number,
+  nodeTag: number,
+  type: "frames" | "spring" | "decay",
+  isRunning: boolean,
+  /**
+   * False for animations stopped before reaching their end.
+   */
+  hasCompleted: boolean,
+  framesCount: number,
+  droppedFramesCount: number,
+  /**
+   * Frames longer than the animation can simulate at once, on which it lagged behind.
+   */
+  clampedFramesCount: number,
+  maxFrameDeltaInMs: number,
+  /**
+   * Time the animation thread spent on the frames the animation was part of.
+   */
+  totalEvaluationTimeInMs: number,
+  maxEvaluationTimeInMs: number,
+}
+
+export type HermesRuntimeConfig = {
+  /**
+   * Default: Hermes' default
+   */
+  initialHeapSizeInBytes?: number,
+  /**
+   * Default: Hermes' default
+   */
+  maxHeapSizeInBytes?: number,
+  /**
+   * How eagerly the GC returns freed heap segments to the OS. Default: Hermes' default
+   */
+  releaseUnusedMemory?: "NONE" | "OLD_GENERATION" | "YOUNG_GENERATION_ON_FULL_GC" | "YOUNG_GENERATION_ALWAYS",
+  /**
+   * Makes Hermes collect GC timing, reported by `RNInstance::getHermesHeapInfo`. Default: false
+   */
+  shouldRecordGCStats?: boolean,
+  /**
+   * On memory pressure, drops the resident pages of a bytecode bundle loaded from a file. They're read from the file
+   * again once the code they hold runs. Default: false
+   */
+  shouldEvictBytecodePagesOnMemoryPressure?: boolean,
+}
+
+/**
+ * Statistics reported by Hermes, e.g. "hermes_heapSize" or "hermes_numCollections", in bytes, counts or milliseconds.
+ */
+export type HermesHeapInfo = Record<string, number>
+
 export interface RNInstance {
   descriptorRegistry: DescriptorRegistry;
 
@@ -99,12 +183,34 @@ export interface RNInstance {
 
   runJSBundle(jsBundleProvider: JSBundleProvider): Promise<void>;
 
+  /**
+   * Makes a segment bundle file available to the running bundle. Segments must be of the main bundle's kind: modules
+   * of indexed RAM segments are evaluated when they're first required, other segments are evaluated right away.
+   * Resolves once the segment is registered, rejects if it doesn't match the main bundle, can't be read or fails.
+   */
+  registerSegment(segmentId: number, segmentPath: string): Promise<void>;
+
   getTurboModule<T extends TurboModule>(name: string): T;
 
   createSurface(appKey: string): SurfaceHandle;
 
   updateState(componentName: string, tag: Tag, state: unknown): void;
 
+  getTextMeasurementCacheStats(): TextMeasurementCacheStats | undefined;
+
+  getTaskLaneStats(): TaskLaneStatsByThread | undefined;
+
+  /**
+   * Running native animations followed by the most recently ended ones, or undefined if native Animated isn't used.
+   */
+  getAnimationTelemetry(): AnimationTelemetry[] | undefined;
+
+  /**
+   * Resolves once the JS thread is free to read the statistics. `includeExpensive` adds statistics that require
+   * walking the heap.
+   */
+  getHermesHeapInfo(includeExpensive?: boolean): Promise<HermesHeapInfo>;
+
   getId(): number;
 
   bindComponentNameToDescriptorType(componentName: string, descriptorType: string);
@@ -126,6 +232,20 @@ export type RNInstanceManager = RNInstance
 
 export type RNInstanceOptions = {
   createRNPackages: (ctx: RNPackageContext) => RNPackage[]
+  /**
+   * Default: "OBJECTS"
+   */
+  mutationsTransport?: MutationsTransport
+  /**
+   * Update mutations carry only changed props, and layout metrics only if they changed. Default: false
+   */
+  enablePropsDiffing?: boolean
+  /**
+   * Native animations that can't benefit from every vsync (e.g. timing animations, sampled at 60 FPS) skip vsyncs on
+   * displays with a higher refresh rate. Default: false
+   */
+  enableAnimationFrameRateThrottling?: boolean
+  hermesRuntimeConfig?: HermesRuntimeConfig
 }
 
 
@@ -144,6 +264,7 @@ export class RNInstanceImpl implements RNInstance {
   private responderLockDispatcher: ResponderLockDispatcher
   private isFeatureFlagEnabledByName = new Map<FeatureFlagName, boolean>()
   private jsPackagerClient: JSPackagerClient
+  private binaryMutationsDecoder = new BinaryMutationsDecoder()
 
   /**
    * @deprecated
@@ -158,7 +279,11 @@ export class RNInstanceImpl implements RNInstance {
     public abilityContext: common.UIAbilityContext,
     private napiBridge: NapiBridge,
     private defaultProps: Record<string, any>,
-    private createRNOHContext: (rnInstance: RNInstance) => RNOHContext
+    private createRNOHContext: (rnInstance: RNInstance) => RNOHContext,
+    private mutationsTransport: MutationsTransport = "OBJECTS",
+    private isPropsDiffingEnabled: boolean = false,
+    private isAnimationFrameRateThrottlingEnabled: boolean = false,
+    private hermesRuntimeConfig: HermesRuntimeConfig = {},
   ) {
     this.logger = logger.clone("RNInstance")
     const stopTracing = this.logger.clone("constructor").startTracing()
@@ -213,8 +338,11 @@ export class RNInstanceImpl implements RNInstance {
     this.napiBridge.createReactNativeInstance(
       this.id,
       this.turboModuleProvider,
-      (mutations) => {
+      (mutations, napiBinderPayloads) => {
         try {
+          if (mutations instanceof ArrayBuffer) {
+            mutations = this.binaryMutationsDecoder.decode(mutations, napiBinderPayloads ?? [])
+          }
           this.descriptorRegistry.applyMutations(mutations)
         } catch (err) {
           if (typeof err === "string") {
@@ -234,6 +362,12 @@ export class RNInstanceImpl implements RNInstance {
       },
       (type, payload) => {
         this.onCppMessage(type, payload)
+      },
+      {
+        mutationsTransport: this.mutationsTransport,
+        isPropsDiffingEnabled: this.isPropsDiffingEnabled,
+        isAnimationFrameRateThrottlingEnabled: this.isAnimationFrameRateThrottlingEnabled,
+        hermesRuntimeConfig: this.hermesRuntimeConfig,
       }
     )
     stopTracing()
@@ -324,8 +458,13 @@ export class RNInstanceImpl implements RNInstance {
     const bundleURL = jsBundleProvider.getURL()
     try {
       this.bundleExecutionStatusByBundleURL.set(bundleURL, "RUNNING")
-      const jsBundle = await jsBundleProvider.getBundle()
-      await this.napiBridge.loadScript(this.id, jsBundle, bundleURL)
+      const bundleFilePath = jsBundleProvider.getBundleFilePath()
+      if (bundleFilePath) {
+        await this.napiBridge.loadScriptFromFile(this.id, bundleFilePath, bundleURL)
+      } else {
+        const jsBundle = await jsBundleProvider.getBundle()
+        await this.napiBridge.loadScript(this.id, jsBundle, bundleURL)
+      }
       const hotReloadConfig = jsBundleProvider.getHotReloadConfig()
       if (hotReloadConfig) {
         this.callRNFunction("HMRClient", "setup", ["harmony", hotReloadConfig.bundleEntry, hotReloadConfig.host, hotReloadConfig.port, true])
@@ -355,6 +494,15 @@ export class RNInstanceImpl implements RNInstance {
     }
   }
 
+  public async registerSegment(segmentId: number, segmentPath: string): Promise<void> {
+    const stopTracing = this.logger.clone(`registerSegment (segmentId: ${segmentId})`).startTracing()
+    try {
+      await this.napiBridge.registerSegment(this.id, segmentId, segmentPath)
+    } finally {
+      stopTracing()
+    }
+  }
+
   public getTurboModule<T extends TurboModule>(name: string): T {
     return this.turboModuleProvider.getModule(name);
   }
@@ -374,17 +522,35 @@ export class RNInstanceImpl implements RNInstance {
     stopTracing()
   }
 
+  public getTextMeasurementCacheStats(): TextMeasurementCacheStats | undefined {
+    return this.napiBridge.getTextMeasurementCacheStats(this.id)
+  }
+
+  public getTaskLaneStats(): TaskLaneStatsByThread | undefined {
+    return this.napiBridge.getTaskLaneStats(this.id)
+  }
+
+  public getAnimationTelemetry(): AnimationTelemetry[] | undefined {
+    return this.napiBridge.getAnimationTelemetry(this.id)
+  }
+
+  public getHermesHeapInfo(includeExpensive: boolean = false): Promise<HermesHeapInfo> {
+    return this.napiBridge.getHermesHeapInfo(this.id, includeExpensive)
+  }
+
   public onBackPress() {
     this.emitDeviceEvent('hardwareBackPress', {})
   }
 
   public onForeground() {
     this.lifecycleState = LifecycleState.READY
+    this.napiBridge.onForeground(this.id)
     this.lifecycleEventEmitter.emit("FOREGROUND")
   }
 
   public onBackground() {
     this.lifecycleState = LifecycleState.PAUSED
+    this.napiBridge.onBackground(this.id)
     this.lifecycleEventEmitter.emit("BACKGROUND")
 
   }
@@ -1,10 +1,9 @@
 import type common from '@ohos.app.ability.common';
-import type { RNInstance} from './RNInstance';
+import type { RNInstance, RNInstanceOptions } from './RNInstance';
 import { RNInstanceImpl } from './RNInstance';
 import type { NapiBridge } from './NapiBridge';
 import type { RNOHContext } from './RNOHContext';
 import type { RNOHLogger } from './RNOHLogger';
-import type { RNPackage, RNPackageContext } from './RNPackage';
 
 
 export class RNInstanceRegistry {
@@ -19,9 +18,7 @@ export class RNInstanceRegistry {
   }
 
   public async createInstance(
-    options: {
-      createRNPackages: (ctx: RNPackageContext) => RNPackage[]
-    }
+    options: RNInstanceOptions
   ): Promise<RNInstance> {
     const id = this.napiBridge.getNextRNInstanceId();
     const instance = new RNInstanceImpl(
@@ -30,7 +27,11 @@ export class RNInstanceRegistry {
       this.abilityContext,
       this.napiBridge,
       this.getDefaultProps(),
-      this.createRNOHContext
+      this.createRNOHContext,
+      options.mutationsTransport,
+      options.enablePropsDiffing,
+      options.enableAnimationFrameRateThrottling,
+      options.hermesRuntimeConfig
     )
     await instance.initialize(options.createRNPackages({}))
     this.instanceMap.set(id, instance)
@@ -10,7 +10,7 @@ export { RNOHContext } from "./RNOHContext"
 export * from "./RNPackage"
 export * from "./TurboModule"
 export * from "./TurboModuleProvider"
-export { RNInstance, RNInstanceManager, LifecycleState, RNInstanceOptions } from "./RNInstance"
+export { RNInstance, RNInstanceManager, LifecycleState, RNInstanceOptions, MutationsTransport, TextMeasurementCacheStats, TaskLaneStats, TaskLaneName, TaskLaneStatsByThread, AnimationTelemetry, HermesRuntimeConfig, HermesHeapInfo } from "./RNInstance"
 export * from "./JSBundleProvider"
 export * from "./RNInstanceRegistry"
 export * from "./TextLayoutManager"
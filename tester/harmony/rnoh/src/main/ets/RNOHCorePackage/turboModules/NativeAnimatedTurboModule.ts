@@ -1,10 +1,65 @@
+import util from '@ohos.util';
 import type { Tag } from '../../RNOH/ts';
 import { TurboModule } from "../../RNOH/TurboModule";
 
+/**
+ * Must be kept in sync with AnimatedPropsBatch.h
+ */
+const RECORD_HEADER_SIZE = 8
+const MATRIX_SIZE = 16
+
+enum AnimatedPropValueType {
+  NUMBER = 0,
+  MATRIX = 1,
+  STRING = 2,
+}
+
 export class NativeAnimatedTurboModule extends TurboModule {
   public static readonly NAME = 'NativeAnimatedTurboModule';
 
+  private propNames: string[] = []
+  private textDecoder = util.TextDecoder.create("utf-8")
+
   public setViewProps(tag: Tag, props: Object) {
     this.ctx.descriptorRegistry.setAnimatedRawProps(tag, props);
   }
+
+  /**
+   * Applies props of all views updated by native animations in a frame. `newPropNames` extend the list of interned
+   * prop names, which the buffer refers to by index.
+   */
+  public setViewPropsBatch(buffer: ArrayBuffer, newPropNames: string[]) {
+    this.propNames.push(...newPropNames)
+    const propsByTag = new Map<Tag, Record<string, number | number[] | string>>()
+    const view = new DataView(buffer)
+    let offset = 0
+    while (offset < buffer.byteLength) {
+      const tag = view.getInt32(offset, true)
+      const propName = this.propNames[view.getUint16(offset + 4, true)]
+      const valueType: AnimatedPropValueType = view.getUint8(offset + 6)
+      offset += RECORD_HEADER_SIZE
+      let value: number | number[] | string
+      if (valueType === AnimatedPropValueType.STRING) {
+        const byteLength = view.getUint32(offset, true)
+        value = this.textDecoder.decodeWithStream(new Uint8Array(buffer, offset + 4, byteLength))
+        offset += 4 + byteLength
+      } else if (valueType === AnimatedPropValueType.MATRIX) {
+        value = new Array(MATRIX_SIZE)
+        for (let i = 0; i < MATRIX_SIZE; i++) {
+          value[i] = view.getFloat64(offset, true)
+          offset += 8
+        }
+      } else {
+        value = view.getFloat64(offset, true)
+        offset += 8
+      }
+      let props = propsByTag.get(tag)
+      if (!props) {
+        props = {}
+        propsByTag.set(tag, props)
+      }
+      props[propName] = value
+    }
+    propsByTag.forEach((props, tag) => this.setViewProps(tag, props))
+  }
 }
@@ -0,0 +1,77 @@
+import type {Descriptor} from '../harmony/rnoh/src/main/ets/RNOH/DescriptorBase';
+import {
+  copyWithoutRawProps,
+  defineLazyRawProps,
+  defineMergedRawProps,
+} from '../harmony/rnoh/src/main/ets/RNOH/LazyRawProps';
+
+function createDescriptor(
+  tag: number,
+  decodeRawProps: () => Object,
+): Descriptor {
+  const descriptor = {
+    tag,
+    type: 'View',
+    nativeId: null,
+    isDynamicBinder: false,
+    props: {},
+    state: {},
+    childrenTags: [],
+  } as unknown as Descriptor;
+  defineLazyRawProps(descriptor, decodeRawProps);
+  return descriptor;
+}
+
+it('should not decode rawProps when copying and merging descriptors', () => {
+  const decodeRawProps = jest.fn(() => ({nativeID: 'foo'}));
+  const currentDescriptor = createDescriptor(1, decodeRawProps);
+  const mutationDescriptor = createDescriptor(1, decodeRawProps);
+
+  const newDescriptor = {
+    ...copyWithoutRawProps(currentDescriptor),
+    ...copyWithoutRawProps(mutationDescriptor),
+  } as Descriptor;
+  defineMergedRawProps(
+    newDescriptor,
+    [currentDescriptor, mutationDescriptor],
+    () => ({...currentDescriptor.rawProps, ...mutationDescriptor.rawProps}),
+  );
+
+  expect(decodeRawProps).not.toHaveBeenCalled();
+  expect(newDescriptor).toMatchObject({tag: 1, type: 'View', nativeId: null});
+});
+
+it('should decode rawProps once, on first access', () => {
+  const currentDescriptor = createDescriptor(1, () => ({a: 1, b: 1}));
+  const decodeRawProps = jest.fn(() => ({b: 2}));
+  const mutationDescriptor = createDescriptor(1, decodeRawProps);
+  const newDescriptor = {
+    ...copyWithoutRawProps(currentDescriptor),
+  } as Descriptor;
+  defineMergedRawProps(
+    newDescriptor,
+    [currentDescriptor, mutationDescriptor],
+    () => ({...currentDescriptor.rawProps, ...mutationDescriptor.rawProps}),
+  );
+
+  expect(newDescriptor.rawProps).toStrictEqual({a: 1, b: 2});
+  expect(newDescriptor.rawProps).toStrictEqual({a: 1, b: 2});
+  expect(decodeRawProps).toHaveBeenCalledTimes(1);
+});
+
+it('should merge rawProps eagerly when too many merges are pending', () => {
+  const decodeRawProps = jest.fn(() => ({}));
+  let descriptor = createDescriptor(1, decodeRawProps);
+  for (let i = 0; i < 16; i++) {
+    const previousDescriptor = descriptor;
+    const mutationDescriptor = createDescriptor(1, decodeRawProps);
+    descriptor = {...copyWithoutRawProps(previousDescriptor)} as Descriptor;
+    defineMergedRawProps(
+      descriptor,
+      [previousDescriptor, mutationDescriptor],
+      () => ({...previousDescriptor.rawProps, ...mutationDescriptor.rawProps}),
+    );
+  }
+
+  expect(decodeRawProps).toHaveBeenCalled();
+});
@@ -1,7 +1,7 @@
-import {StyleSheet, Text, View} from 'react-native';
+import {ScrollView, StyleSheet, Text, View} from 'react-native';
 import {TestSuite, TestCase} from '@rnoh/testerino';
 import {Button, PressCounter} from '../components';
-import {useState} from 'react';
+import {useRef, useState} from 'react';
 
 const SAMPLE_PARAGRAPH_TEXT =
   'Quis exercitation do eu in laboris nulla sit elit officia. Incididunt ipsum aliquip commodo proident ad laborum aliquip fugiat sunt aute ea laboris mollit reprehenderit. Culpa non incididunt cupidatat esse laborum nulla quis mollit voluptate proident commodo. Consectetur ad deserunt do nulla sunt veniam magna laborum reprehenderit et ullamco fugiat fugiat.';
@@ -97,6 +97,17 @@ export function TextTest() {
           expect(state).to.have.all.keys('x', 'y', 'width', 'height');
         }}
       />
+      <TestCase
+        itShould="measure the same text without a width constraint consistently"
+        initialState={[] as number[]}
+        arrange={ctx => <UnconstrainedTextsView ctx={ctx} />}
+        assert={({expect, state}) => {
+          expect(state).to.have.length(2);
+          expect(state[0]).to.be.greaterThan(0);
+          expect(state[0]).to.be.lessThan(10000);
+          expect(state[0]).to.be.equal(state[1]);
+        }}
+      />
       <TestSuite name="TextStyle">
         <TestCase itShould="show text with the Pacifico Regular font">
           <View style={{height: 30, width: '100%'}}>
@@ -1181,6 +1192,38 @@ const OnLayoutView = (props: {
     </View>
   );
 };
+/**
+ * A horizontal ScrollView doesn't constrain the width of its content, so the texts are measured with an infinite
+ * maximum width. The second one is measured from the text measurement cache.
+ */
+const UnconstrainedTextsView = (props: {
+  ctx: {
+    state: number[];
+    setState: React.Dispatch<React.SetStateAction<number[]>>;
+    reset: () => void;
+  };
+}) => {
+  const widths = useRef<number[]>([]);
+  const onLayout = (idx: number, width: number) => {
+    widths.current[idx] = width;
+    if (widths.current.filter(w => w !== undefined).length === 2) {
+      props.ctx.setState([...widths.current]);
+    }
+  };
+  return (
+    <View>
+      {[0, 1].map(idx => (
+        <ScrollView key={idx} horizontal>
+          <Text
+            style={{fontSize: 16}}
+            onLayout={event => onLayout(idx, event.nativeEvent.layout.width)}>
+            {SAMPLE_PARAGRAPH_TEXT}
+          </Text>
+        </ScrollView>
+      ))}
+    </View>
+  );
+};
 const OnTextLayoutView = (props: {
   ctx: {
     state: boolean;